@@ -0,0 +1,106 @@
+#include "AST.hpp"
+#include <cstring>
+
+namespace SCERSE {
+
+namespace {
+
+// FNV-1a
+uint64_t hashString(std::string_view text) {
+    uint64_t hash = 1469598103934665603ull;
+    for (char c : text) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+} // namespace
+
+char* StringPool::allocate(size_t length) {
+    if (length > BLOCK_SIZE / 4) {
+        // Large strings get a block of their own; the current block stays open
+        blocks.emplace_back(new char[length]);
+        char* data = blocks.back().get();
+        if (blocks.size() > 1) std::swap(blocks.back(), blocks[blocks.size() - 2]);
+        return data;
+    }
+    if (blockUsed + length > BLOCK_SIZE) {
+        blocks.emplace_back(new char[BLOCK_SIZE]);
+        blockUsed = 0;
+    }
+    char* data = blocks.back().get() + blockUsed;
+    blockUsed += length;
+    return data;
+}
+
+void StringPool::grow() {
+    std::vector<std::string_view> old(slots.empty() ? 256 : slots.size() * 2);
+    old.swap(slots);
+    const size_t mask = slots.size() - 1;
+    for (std::string_view text : old) {
+        if (!text.data()) continue;
+        size_t slot = hashString(text) & mask;
+        while (slots[slot].data()) slot = (slot + 1) & mask;
+        slots[slot] = text;
+    }
+}
+
+std::string_view StringPool::intern(std::string_view text) {
+    if (text.empty()) return std::string_view();
+    if ((used + 1) * 2 > slots.size()) grow();
+
+    const size_t mask = slots.size() - 1;
+    size_t slot = hashString(text) & mask;
+    while (slots[slot].data()) {
+        if (slots[slot] == text) return slots[slot];
+        slot = (slot + 1) & mask;
+    }
+
+    char* data = allocate(text.size());
+    std::memcpy(data, text.data(), text.size());
+    slots[slot] = std::string_view(data, text.size());
+    ++used;
+    return slots[slot];
+}
+
+void StringPool::clear() {
+    blocks.clear();
+    blockUsed = BLOCK_SIZE;
+    slots.clear();
+    used = 0;
+}
+
+NodeId ASTArena::add(ASTNodeType type, std::string_view value, SourcePosition position) {
+    ASTNode node;
+    node.type = type;
+    node.position = position;
+    node.value = strings.intern(value);
+    nodes.push_back(node);
+    return static_cast<NodeId>(nodes.size() - 1);
+}
+
+void ASTArena::appendChild(NodeId parent, NodeId child) {
+    ASTNode& p = nodes[parent];
+    if (p.lastChild == NO_NODE) {
+        p.firstChild = child;
+    } else {
+        nodes[p.lastChild].nextSibling = child;
+    }
+    p.lastChild = child;
+}
+
+void ASTArena::prependChild(NodeId parent, NodeId child) {
+    ASTNode& p = nodes[parent];
+    nodes[child].nextSibling = p.firstChild;
+    p.firstChild = child;
+    if (p.lastChild == NO_NODE) p.lastChild = child;
+}
+
+void ASTArena::clear() {
+    nodes.clear();
+    strings.clear();
+    rootNode = NO_NODE;
+}
+
+} // namespace SCERSE
@@ -1,67 +1,178 @@
-#pragma once
-#include <memory>
-#include <vector>
-#include <string>
-#include "Types.hpp"
-
-namespace SCERSE {
-
-// Define SourcePosition if not already defined elsewhere
-struct SourcePosition {
-    int line;
-    int column;
-    
-    SourcePosition() : line(0), column(0) {}
-    SourcePosition(int l, int c) : line(l), column(c) {}
-};
-
-enum class ASTNodeType {
-    // Program structure
-    PROGRAM,
-    STATEMENT_LIST,
-    STATEMENT,
-    EXPRESSION,
-    TERM,
-    FACTOR,
-    
-    // Declarations
-    VARIABLE_DECLARATION,
-    FUNCTION_DECLARATION,
-    PARAMETER_LIST,
-    TYPE_SPECIFIER,
-    
-    // Statements
-    BLOCK_STATEMENT,
-    EXPRESSION_STATEMENT,
-    RETURN_STATEMENT,
-    IF_STATEMENT,
-    WHILE_STATEMENT,
-    FOR_STATEMENT,
-    
-    // Expressions
-    ASSIGNMENT,
-    BINARY_OPERATION,
-    UNARY_OPERATION,
-    FUNCTION_CALL,
-    
-    // Literals and identifiers
-    IDENTIFIER,
-    LITERAL,
-    
-    // Additional (add as needed)
-    EMPTY
-};
-
-struct ASTNode {
-    ASTNodeType type;
-    std::string value;
-    SourcePosition position;
-    std::vector<std::shared_ptr<ASTNode>> children;
-
-    ASTNode(ASTNodeType t) : type(t) {}
-    ASTNode(ASTNodeType t, const std::string& v) : type(t), value(v) {}
-    ASTNode(ASTNodeType t, const std::string& v, SourcePosition pos) 
-        : type(t), value(v), position(pos) {}
-};
-
-} // namespace SCERSE
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <string>
+#include <string_view>
+#include "Types.hpp"
+
+namespace SCERSE {
+
+// Define SourcePosition if not already defined elsewhere
+struct SourcePosition {
+    int line;
+    int column;
+    
+    SourcePosition() : line(0), column(0) {}
+    SourcePosition(int l, int c) : line(l), column(c) {}
+};
+
+enum class ASTNodeType {
+    // Program structure
+    PROGRAM,
+    STATEMENT_LIST,
+    STATEMENT,
+    EXPRESSION,
+    TERM,
+    FACTOR,
+    
+    // Declarations
+    VARIABLE_DECLARATION,
+    FUNCTION_DECLARATION,
+    PARAMETER_LIST,
+    TYPE_SPECIFIER,
+    
+    // Statements
+    BLOCK_STATEMENT,
+    EXPRESSION_STATEMENT,
+    RETURN_STATEMENT,
+    IF_STATEMENT,
+    WHILE_STATEMENT,
+    FOR_STATEMENT,
+    
+    // Expressions
+    ASSIGNMENT,
+    BINARY_OPERATION,
+    UNARY_OPERATION,
+    FUNCTION_CALL,
+    
+    // Literals and identifiers
+    IDENTIFIER,
+    LITERAL,
+    
+    // Additional (add as needed)
+    EMPTY
+};
+
+using NodeId = uint32_t;
+constexpr NodeId NO_NODE = 0xFFFFFFFFu;
+
+/**
+ * ASTNode
+ * One node of an ASTArena. Children are linked first-child/next-sibling
+ * by index; value points into the arena's string pool.
+ */
+struct ASTNode {
+    ASTNodeType type;
+    SourcePosition position;
+    std::string_view value;
+    NodeId firstChild = NO_NODE;
+    NodeId lastChild = NO_NODE;
+    NodeId nextSibling = NO_NODE;
+};
+
+/**
+ * StringPool
+ * Interns strings into large blocks. Views stay valid until clear() or
+ * destruction, including after the pool is moved.
+ */
+class StringPool {
+public:
+    StringPool() = default;
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+    StringPool(StringPool&&) noexcept = default;
+    StringPool& operator=(StringPool&&) noexcept = default;
+
+    std::string_view intern(std::string_view text);
+    void clear();
+
+private:
+    static constexpr size_t BLOCK_SIZE = 16 * 1024;
+
+    std::vector<std::unique_ptr<char[]>> blocks;
+    size_t blockUsed = BLOCK_SIZE;      // forces a block on first use
+    std::vector<std::string_view> slots;  // open addressing; empty = null data()
+    size_t used = 0;
+
+    char* allocate(size_t length);
+    void grow();
+};
+
+/**
+ * ASTArena
+ * A whole AST: nodes stored contiguously and addressed by NodeId, with
+ * their strings in one pool. Nothing is freed node by node; the tree
+ * goes away in a handful of deallocations when the arena does.
+ * Move-only, since node values point into the pool.
+ */
+class ASTArena {
+public:
+    /**
+     * Iterates the children of one node, in order
+     */
+    class ChildRange {
+    public:
+        class iterator {
+        public:
+            iterator(const ASTNode* nodes, NodeId id) : nodes(nodes), id(id) {}
+            NodeId operator*() const { return id; }
+            iterator& operator++() { id = nodes[id].nextSibling; return *this; }
+            bool operator!=(const iterator& other) const { return id != other.id; }
+        private:
+            const ASTNode* nodes;
+            NodeId id;
+        };
+
+        ChildRange(const ASTNode* nodes, NodeId first) : nodes(nodes), first(first) {}
+        iterator begin() const { return iterator(nodes, first); }
+        iterator end() const { return iterator(nodes, NO_NODE); }
+        bool empty() const { return first == NO_NODE; }
+    private:
+        const ASTNode* nodes;
+        NodeId first;
+    };
+
+    ASTArena() = default;
+    ASTArena(const ASTArena&) = delete;
+    ASTArena& operator=(const ASTArena&) = delete;
+    ASTArena(ASTArena&&) noexcept = default;
+    ASTArena& operator=(ASTArena&&) noexcept = default;
+
+    /**
+     * Add an unlinked node; value is copied into the pool
+     */
+    NodeId add(ASTNodeType type, std::string_view value = std::string_view(),
+               SourcePosition position = SourcePosition());
+
+    /**
+     * Link child (a node without a parent) as the last child of parent
+     */
+    void appendChild(NodeId parent, NodeId child);
+
+    /**
+     * Link child as the first child of parent (builds right-recursive
+     * lists in order); child's previous sibling link is replaced
+     */
+    void prependChild(NodeId parent, NodeId child);
+
+    const ASTNode& operator[](NodeId id) const { return nodes[id]; }
+    ASTNode& operator[](NodeId id) { return nodes[id]; }
+    ChildRange children(NodeId id) const { return ChildRange(nodes.data(), nodes[id].firstChild); }
+
+    NodeId root() const { return rootNode; }
+    void setRoot(NodeId id) { rootNode = id; }
+    explicit operator bool() const { return rootNode != NO_NODE; }
+
+    size_t size() const { return nodes.size(); }
+    void reserve(size_t count) { nodes.reserve(count); }
+    void clear();
+
+private:
+    std::vector<ASTNode> nodes;
+    StringPool strings;
+    NodeId rootNode = NO_NODE;
+};
+
+} // namespace SCERSE
@@ -0,0 +1,162 @@
+#include "MappedFile.hpp"
+#include <utility>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace SCERSE {
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        buffer = std::move(other.buffer);
+        ptr = other.mapped ? other.ptr : buffer.data();
+        length = other.length;
+        opened = other.opened;
+        mapped = other.mapped;
+#ifdef _WIN32
+        mappingHandle = other.mappingHandle;
+        other.mappingHandle = nullptr;
+#endif
+        other.ptr = nullptr;
+        other.length = 0;
+        other.opened = false;
+        other.mapped = false;
+    }
+    return *this;
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping) {
+            void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            if (view) {
+                CloseHandle(file);
+                mappingHandle = mapping;
+                ptr = static_cast<const char*>(view);
+                length = static_cast<size_t>(fileSize.QuadPart);
+                opened = mapped = true;
+                return true;
+            }
+            CloseHandle(mapping);
+        }
+    }
+    // Empty files, pipes and mapping failures: read the bytes instead
+    bool ok = readIntoBuffer(file);
+    CloseHandle(file);
+    return ok;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (view != MAP_FAILED) {
+            ::close(fd);
+            ptr = static_cast<const char*>(view);
+            length = static_cast<size_t>(st.st_size);
+            opened = mapped = true;
+            return true;
+        }
+    }
+    // Empty files, pipes and mapping failures: read the bytes instead. The
+    // descriptor already open is read to the end; opening the path again
+    // would lose what a FIFO's writer has sent.
+    bool ok = readIntoBuffer(fd);
+    ::close(fd);
+    return ok;
+#endif
+}
+
+#ifdef _WIN32
+bool MappedFile::readIntoBuffer(void* file) {
+    const size_t chunk = 64 * 1024;
+    for (;;) {
+        size_t used = buffer.size();
+        buffer.resize(used + chunk);
+        DWORD got = 0;
+        if (!ReadFile(static_cast<HANDLE>(file), buffer.data() + used, static_cast<DWORD>(chunk), &got, nullptr)) {
+            // The write end of a pipe closing is the end of input
+            if (GetLastError() != ERROR_BROKEN_PIPE) {
+                buffer.clear();
+                return false;
+            }
+            got = 0;
+        }
+        buffer.resize(used + got);
+        if (got == 0) break;
+    }
+#else
+bool MappedFile::readIntoBuffer(int fd) {
+    const size_t chunk = 64 * 1024;
+    for (;;) {
+        size_t used = buffer.size();
+        buffer.resize(used + chunk);
+        ssize_t got = ::read(fd, buffer.data() + used, chunk);
+        if (got < 0) {
+            buffer.resize(used);
+            if (errno == EINTR) continue;
+            buffer.clear();
+            return false;
+        }
+        buffer.resize(used + static_cast<size_t>(got));
+        if (got == 0) break;
+    }
+#endif
+    ptr = buffer.data();
+    length = buffer.size();
+    opened = true;
+    mapped = false;
+    return true;
+}
+
+void MappedFile::close() {
+    if (mapped && ptr) {
+#ifdef _WIN32
+        UnmapViewOfFile(ptr);
+        CloseHandle(mappingHandle);
+        mappingHandle = nullptr;
+#else
+        munmap(const_cast<char*>(ptr), length);
+#endif
+    }
+    buffer.clear();
+    buffer.shrink_to_fit();
+    ptr = nullptr;
+    length = 0;
+    opened = false;
+    mapped = false;
+}
+
+} // namespace SCERSE
@@ -0,0 +1,51 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace SCERSE {
+
+/**
+ * MappedFile
+ * Read-only view of a whole file. The file is memory-mapped where the
+ * platform allows it; otherwise (or if mapping fails) it is read into an
+ * owned buffer, so callers always get a contiguous data()/size() range.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * Open and map the file; returns false if it cannot be read
+     */
+    bool open(const std::string& path);
+    void close();
+
+    const char* data() const { return ptr; }
+    size_t size() const { return length; }
+    bool isOpen() const { return opened; }
+    bool isMapped() const { return mapped; }
+
+private:
+    const char* ptr = nullptr;
+    size_t length = 0;
+    bool opened = false;
+    bool mapped = false;
+    std::vector<char> buffer;   // fallback storage when not mapped
+
+#ifdef _WIN32
+    void* mappingHandle = nullptr;
+
+    bool readIntoBuffer(void* file);
+#else
+    bool readIntoBuffer(int fd);
+#endif
+};
+
+} // namespace SCERSE
@@ -0,0 +1,86 @@
+#include "ThreadPool.hpp"
+
+namespace SCERSE {
+
+ThreadPool::ThreadPool(unsigned threads) {
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+    }
+    for (unsigned i = 1; i < threads; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& fn) {
+    if (count == 0) return;
+
+    // Not worth waking anyone for a single item
+    if (workers.empty() || count == 1) {
+        for (size_t i = 0; i < count; ++i) fn(i);
+        return;
+    }
+
+    std::lock_guard<std::mutex> call(callMutex);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &fn;
+        jobCount = count;
+        nextIndex = 0;
+        busyWorkers = workers.size();
+        error = nullptr;
+        ++generation;
+    }
+    wake.notify_all();
+
+    runJob();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this]() { return busyWorkers == 0; });
+    job = nullptr;
+    if (error) {
+        std::exception_ptr failure = error;
+        error = nullptr;
+        std::rethrow_exception(failure);
+    }
+}
+
+void ThreadPool::runJob() {
+    for (size_t i = nextIndex.fetch_add(1); i < jobCount; i = nextIndex.fetch_add(1)) {
+        try {
+            (*job)(i);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) error = std::current_exception();
+        }
+    }
+}
+
+void ThreadPool::workerLoop() {
+    uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&]() { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+
+        runJob();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busyWorkers == 0) done.notify_one();
+    }
+}
+
+} // namespace SCERSE
@@ -0,0 +1,60 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SCERSE {
+
+/**
+ * ThreadPool
+ * Fixed set of worker threads for data-parallel loops. The calling thread
+ * takes part in every loop, so a pool of N threads starts N - 1 workers.
+ */
+class ThreadPool {
+public:
+    /**
+     * threads == 0 uses std::thread::hardware_concurrency()
+     */
+    explicit ThreadPool(unsigned threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned size() const { return static_cast<unsigned>(workers.size()) + 1; }
+
+    /**
+     * Run fn(i) for every i in [0, count) and wait for all of them.
+     * Indices are handed out dynamically, so fn must not depend on which
+     * thread runs it. The first exception thrown by fn is rethrown here.
+     * Concurrent calls are serialized.
+     */
+    void parallelFor(size_t count, const std::function<void(size_t)>& fn);
+
+private:
+    std::vector<std::thread> workers;
+
+    std::mutex callMutex;              // one parallelFor at a time
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+
+    const std::function<void(size_t)>* job = nullptr;
+    size_t jobCount = 0;
+    std::atomic<size_t> nextIndex{0};
+    size_t busyWorkers = 0;
+    uint64_t generation = 0;
+    bool stopping = false;
+    std::exception_ptr error;
+
+    void workerLoop();
+    void runJob();
+};
+
+} // namespace SCERSE
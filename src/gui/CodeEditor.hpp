@@ -1,62 +1,62 @@
-#pragma once
-
-#include <QPlainTextEdit>
-#include <QWidget>
-
-QT_BEGIN_NAMESPACE
-class QPaintEvent;
-class QResizeEvent;
-QT_END_NAMESPACE
-
-namespace SCERSE {
-
-class LineNumberArea;
-class SyntaxHighlighter;  // ADD THIS LINE
-
-class CodeEditor : public QPlainTextEdit
-{
-    Q_OBJECT
-
-public:
-    explicit CodeEditor(QWidget *parent = nullptr);
-    void lineNumberAreaPaintEvent(QPaintEvent *event);
-    int lineNumberAreaWidth();
-    int getCurrentLine() const;
-    int getCurrentColumn() const;
-    void highlightErrorLine(int lineNumber);
-    void highlightSuggestionLine(int lineNumber, const QColor& color);
-    void clearErrorHighlighting();
-
-protected:
-    void resizeEvent(QResizeEvent *event) override;
-
-private slots:
-    void updateLineNumberAreaWidth(int newBlockCount);
-    void highlightCurrentLine();
-    void updateLineNumberArea(const QRect &rect, int dy);
-
-private:
-    QWidget *lineNumberArea;
-    SyntaxHighlighter *syntaxHighlighter;  // ADD THIS LINE
-};
-
-class LineNumberArea : public QWidget
-{
-public:
-    explicit LineNumberArea(CodeEditor *editor)
-        : QWidget(editor), codeEditor(editor) {}
-
-    QSize sizeHint() const override {
-        return QSize(codeEditor->lineNumberAreaWidth(), 0);
-    }
-
-protected:
-    void paintEvent(QPaintEvent *event) override {
-        codeEditor->lineNumberAreaPaintEvent(event);
-    }
-
-private:
-    CodeEditor *codeEditor;
-};
-
-} // namespace SCERSE
+#pragma once
+
+#include <QPlainTextEdit>
+#include <QWidget>
+
+QT_BEGIN_NAMESPACE
+class QPaintEvent;
+class QResizeEvent;
+QT_END_NAMESPACE
+
+namespace SCERSE {
+
+class LineNumberArea;
+class SyntaxHighlighter;  // ADD THIS LINE
+
+class CodeEditor : public QPlainTextEdit
+{
+    Q_OBJECT
+
+public:
+    explicit CodeEditor(QWidget *parent = nullptr);
+    void lineNumberAreaPaintEvent(QPaintEvent *event);
+    int lineNumberAreaWidth();
+    int getCurrentLine() const;
+    int getCurrentColumn() const;
+    void highlightErrorLine(int lineNumber);
+    void highlightSuggestionLine(int lineNumber, const QColor& color);
+    void clearErrorHighlighting();
+
+protected:
+    void resizeEvent(QResizeEvent *event) override;
+
+private slots:
+    void updateLineNumberAreaWidth(int newBlockCount);
+    void highlightCurrentLine();
+    void updateLineNumberArea(const QRect &rect, int dy);
+
+private:
+    QWidget *lineNumberArea;
+    SyntaxHighlighter *syntaxHighlighter;  // ADD THIS LINE
+};
+
+class LineNumberArea : public QWidget
+{
+public:
+    explicit LineNumberArea(CodeEditor *editor)
+        : QWidget(editor), codeEditor(editor) {}
+
+    QSize sizeHint() const override {
+        return QSize(codeEditor->lineNumberAreaWidth(), 0);
+    }
+
+protected:
+    void paintEvent(QPaintEvent *event) override {
+        codeEditor->lineNumberAreaPaintEvent(event);
+    }
+
+private:
+    CodeEditor *codeEditor;
+};
+
+} // namespace SCERSE
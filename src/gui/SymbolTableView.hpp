@@ -1,12 +1,12 @@
-#pragma once
-#include <QTreeWidget>
-#include "../semantic/SymbolTable.hpp"
-
-namespace SCERSE {
-class SymbolTableView : public QTreeWidget {
-    Q_OBJECT
-public:
-    SymbolTableView(QWidget* parent = nullptr);
-    void updateSymbolTable(const SymbolTable& table);
-};
-}
+#pragma once
+#include <QTreeWidget>
+#include "../semantic/SymbolTable.hpp"
+
+namespace SCERSE {
+class SymbolTableView : public QTreeWidget {
+    Q_OBJECT
+public:
+    SymbolTableView(QWidget* parent = nullptr);
+    void updateSymbolTable(const SymbolTable& table);
+};
+}
@@ -1,76 +1,106 @@
-#include "SyntaxHighlighter.hpp"
-
-namespace SCERSE {
-
-SyntaxHighlighter::SyntaxHighlighter(QTextDocument* parent)
-    : QSyntaxHighlighter(parent)
-{
-    HighlightingRule rule;
-
-    // Keyword format (bold blue)
-    keywordFormat.setForeground(QColor(0, 0, 255));
-    keywordFormat.setFontWeight(QFont::Bold);
-    
-    QStringList keywordPatterns;
-    keywordPatterns << "\\bvar\\b" << "\\bint\\b" << "\\bfloat\\b" 
-                    << "\\bbool\\b" << "\\bstring\\b" << "\\bif\\b" 
-                    << "\\belse\\b" << "\\bwhile\\b" << "\\bfor\\b" 
-                    << "\\bfunction\\b" << "\\breturn\\b" << "\\bconst\\b" 
-                    << "\\btrue\\b" << "\\bfalse\\b" << "\\bvoid\\b";
-    
-    for (const QString &pattern : keywordPatterns) {
-        rule.pattern = QRegularExpression(pattern);
-        rule.format = keywordFormat;
-        highlightingRules.append(rule);
-    }
-
-    // Number format (dark magenta)
-    numberFormat.setForeground(QColor(139, 0, 139));
-    rule.pattern = QRegularExpression("\\b[0-9]+\\.?[0-9]*\\b");
-    rule.format = numberFormat;
-    highlightingRules.append(rule);
-
-    // String format (dark green)
-    stringFormat.setForeground(QColor(0, 128, 0));
-    rule.pattern = QRegularExpression("\".*\"");
-    rule.format = stringFormat;
-    highlightingRules.append(rule);
-
-    // Operator format (dark red)
-    operatorFormat.setForeground(QColor(139, 0, 0));
-    QStringList operatorPatterns;
-    operatorPatterns << "\\+|\\-|\\*|\\/|%|="
-                     << "==|!=|<|<=|>|>="
-                     << "&&|\\|\\||!"
-                     << ";|,|\\.|\\(|\\)|\\{|\\}|\\[|\\]";
-    
-    for (const QString &pattern : operatorPatterns) {
-        rule.pattern = QRegularExpression(pattern);
-        rule.format = operatorFormat;
-        highlightingRules.append(rule);
-    }
-
-    // Comment format (gray, italic)
-    commentFormat.setForeground(QColor(128, 128, 128));
-    commentFormat.setFontItalic(true);
-    rule.pattern = QRegularExpression("//[^\\n]*");
-    rule.format = commentFormat;
-    highlightingRules.append(rule);
-
-    // Identifier format (default black)
-    identifierFormat.setForeground(QColor(0, 0, 0));
-}
-
-void SyntaxHighlighter::highlightBlock(const QString &text)
-{
-    // Apply all highlighting rules
-    for (const HighlightingRule &rule : std::as_const(highlightingRules)) {
-        QRegularExpressionMatchIterator matchIterator = rule.pattern.globalMatch(text);
-        while (matchIterator.hasNext()) {
-            QRegularExpressionMatch match = matchIterator.next();
-            setFormat(match.capturedStart(), match.capturedLength(), rule.format);
-        }
-    }
-}
-
-} // namespace SCERSE
+#include "SyntaxHighlighter.hpp"
+#include "../lexer/TokenDfa.hpp"
+#include <QByteArray>
+#include <QVector>
+
+namespace SCERSE {
+
+SyntaxHighlighter::SyntaxHighlighter(QTextDocument* parent)
+    : QSyntaxHighlighter(parent)
+{
+    // Keyword format (bold blue)
+    keywordFormat.setForeground(QColor(0, 0, 255));
+    keywordFormat.setFontWeight(QFont::Bold);
+
+    // Number format (dark magenta)
+    numberFormat.setForeground(QColor(139, 0, 139));
+
+    // String format (dark green)
+    stringFormat.setForeground(QColor(0, 128, 0));
+
+    // Operator format (dark red)
+    operatorFormat.setForeground(QColor(139, 0, 0));
+
+    // Comment format (gray, italic)
+    commentFormat.setForeground(QColor(128, 128, 128));
+    commentFormat.setFontItalic(true);
+
+    // Identifier format (default black)
+    identifierFormat.setForeground(QColor(0, 0, 0));
+}
+
+const QTextCharFormat* SyntaxHighlighter::formatFor(TokenType type) const
+{
+    Token token(type);
+    if (token.isKeyword()) return &keywordFormat;
+
+    switch (type) {
+        case TokenType::INTEGER:
+        case TokenType::FLOAT:
+            return &numberFormat;
+        case TokenType::STRING:
+            return &stringFormat;
+        case TokenType::COMMENT:
+            return &commentFormat;
+        case TokenType::IDENTIFIER:
+            return nullptr;
+        default:
+            return &operatorFormat;
+    }
+}
+
+void SyntaxHighlighter::highlightBlock(const QString &text)
+{
+    const QByteArray utf8 = text.toUtf8();
+    const char* begin = utf8.constData();
+    const char* end = begin + utf8.size();
+
+    // The DFA works on bytes and setFormat on UTF-16 units; the two only
+    // differ once the line has a non-ASCII character
+    QVector<int> unitAt;
+    if (utf8.size() != text.size()) {
+        unitAt.reserve(utf8.size() + 1);
+        for (int i = 0; i < text.size(); ++i) {
+            const char16_t c = text.at(i).unicode();
+            int bytes = 1;
+            if (c >= 0x800) bytes = 3;
+            else if (c >= 0x80) bytes = 2;
+            if (text.at(i).isHighSurrogate() && i + 1 < text.size() && text.at(i + 1).isLowSurrogate()) {
+                // A surrogate pair is 4 bytes for 2 units
+                unitAt.insert(unitAt.size(), 4, i);
+                ++i;
+                continue;
+            }
+            unitAt.insert(unitAt.size(), bytes, i);
+        }
+        unitAt.append(text.size());
+    }
+    auto unit = [&](const char* p) {
+        const int offset = static_cast<int>(p - begin);
+        return unitAt.isEmpty() ? offset : unitAt[offset];
+    };
+
+    const TokenDfa& dfa = TokenDfa::shared();
+    const ScanFunctions& scan = scanFunctions();
+    const char* p = begin;
+    while (p < end) {
+        if (*p == ' ' || (*p >= '\t' && *p <= '\r')) {
+            ++p;
+            continue;
+        }
+
+        TokenDfa::Match match = dfa.match(p, end, scan);
+        if (match.length == 0) {
+            ++p;   // not a token: leave it unformatted
+            continue;
+        }
+
+        if (const QTextCharFormat* format = formatFor(match.type)) {
+            const int first = unit(p);
+            setFormat(first, unit(p + match.length) - first, *format);
+        }
+        p += match.length;
+    }
+}
+
+} // namespace SCERSE
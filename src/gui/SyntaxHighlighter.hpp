@@ -1,34 +1,39 @@
-#pragma once
-
-#include <QSyntaxHighlighter>
-#include <QTextDocument>
-#include <QTextCharFormat>
-#include <QRegularExpression>
-
-namespace SCERSE {
-
-class SyntaxHighlighter : public QSyntaxHighlighter {
-    Q_OBJECT
-
-public:
-    explicit SyntaxHighlighter(QTextDocument* parent = nullptr);
-
-protected:
-    void highlightBlock(const QString &text) override;
-
-private:
-    struct HighlightingRule {
-        QRegularExpression pattern;
-        QTextCharFormat format;
-    };
-    QVector<HighlightingRule> highlightingRules;
-
-    QTextCharFormat keywordFormat;
-    QTextCharFormat identifierFormat;
-    QTextCharFormat numberFormat;
-    QTextCharFormat stringFormat;
-    QTextCharFormat operatorFormat;
-    QTextCharFormat commentFormat;
-};
-
-} // namespace SCERSE
+#pragma once
+
+#include <QSyntaxHighlighter>
+#include <QTextDocument>
+#include <QTextCharFormat>
+#include "../lexer/Token.hpp"
+
+namespace SCERSE {
+
+/**
+ * SyntaxHighlighter
+ * Colors each line by the tokens the Lexer would produce: both run the
+ * TokenDfa built from tokenRules(), so the editor cannot disagree with
+ * the parser about where a token starts or ends.
+ */
+class SyntaxHighlighter : public QSyntaxHighlighter {
+    Q_OBJECT
+
+public:
+    explicit SyntaxHighlighter(QTextDocument* parent = nullptr);
+
+protected:
+    void highlightBlock(const QString &text) override;
+
+private:
+    /**
+     * Format for a token of 'type'; nullptr leaves it unformatted
+     */
+    const QTextCharFormat* formatFor(TokenType type) const;
+
+    QTextCharFormat keywordFormat;
+    QTextCharFormat identifierFormat;
+    QTextCharFormat numberFormat;
+    QTextCharFormat stringFormat;
+    QTextCharFormat operatorFormat;
+    QTextCharFormat commentFormat;
+};
+
+} // namespace SCERSE
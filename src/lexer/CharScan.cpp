@@ -0,0 +1,270 @@
+#include "CharScan.hpp"
+#include <atomic>
+#include <initializer_list>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define SCERSE_SCAN_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// GCC and Clang only emit AVX2 instructions in functions marked for it;
+// the file itself is built for the baseline x86-64 (SSE2)
+#if defined(__GNUC__) || defined(__clang__)
+#define SCERSE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define SCERSE_TARGET_AVX2
+#endif
+
+namespace SCERSE {
+
+namespace {
+
+enum : unsigned char { WHITESPACE = 1, IDENTIFIER = 2, DIGIT = 4 };
+
+// Class bits per byte value; what isspace/isalnum/isdigit give in the C locale
+struct CharClasses {
+    unsigned char bits[256] = {};
+
+    constexpr CharClasses() {
+        for (int c : {' ', '\t', '\n', '\v', '\f', '\r'}) bits[c] = WHITESPACE;
+        for (int c = '0'; c <= '9'; ++c) bits[c] = IDENTIFIER | DIGIT;
+        for (int c = 'a'; c <= 'z'; ++c) bits[c] = IDENTIFIER;
+        for (int c = 'A'; c <= 'Z'; ++c) bits[c] = IDENTIFIER;
+        bits[static_cast<int>('_')] = IDENTIFIER;
+    }
+};
+
+constexpr CharClasses CLASSES;
+
+inline bool is(char c, unsigned char mask) {
+    return (CLASSES.bits[static_cast<unsigned char>(c)] & mask) != 0;
+}
+
+const char* whitespaceScalar(const char* p, const char* end, size_t& newlines, const char*& lineStart) {
+    for (; p < end && is(*p, WHITESPACE); ++p) {
+        if (*p == '\n') {
+            ++newlines;
+            lineStart = p + 1;
+        }
+    }
+    return p;
+}
+
+const char* identifierScalar(const char* p, const char* end) {
+    while (p < end && is(*p, IDENTIFIER)) ++p;
+    return p;
+}
+
+const char* digitsScalar(const char* p, const char* end) {
+    while (p < end && is(*p, DIGIT)) ++p;
+    return p;
+}
+
+const ScanFunctions SCALAR_SCANS = {whitespaceScalar, identifierScalar, digitsScalar};
+
+#ifdef SCERSE_SCAN_X86
+
+inline unsigned lowestBit(unsigned mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return index;
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+inline unsigned highestBit(unsigned mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse(&index, mask);
+    return index;
+#else
+    return 31u - static_cast<unsigned>(__builtin_clz(mask));
+#endif
+}
+
+inline unsigned bitCount(unsigned mask) {
+#ifdef _MSC_VER
+    unsigned count = 0;
+    for (; mask; mask &= mask - 1) ++count;
+    return count;
+#else
+    return static_cast<unsigned>(__builtin_popcount(mask));
+#endif
+}
+
+// 'lines' marks the newlines of a block and 'stop' the bytes that end the
+// run; count the newlines before the first stop
+inline void countLines(const char* block, unsigned lines, unsigned stop,
+                       size_t& newlines, const char*& lineStart) {
+    if (stop) lines &= (1u << lowestBit(stop)) - 1;
+    if (lines) {
+        newlines += bitCount(lines);
+        lineStart = block + highestBit(lines) + 1;
+    }
+}
+
+// Signed bytes: one add moves [first, first + count) to the bottom of the
+// range, so a single compare tests it
+inline __m128i inRange(__m128i v, int first, int count) {
+    __m128i shifted = _mm_add_epi8(v, _mm_set1_epi8(static_cast<char>(0x80 - first)));
+    return _mm_cmplt_epi8(shifted, _mm_set1_epi8(static_cast<char>(-128 + count)));
+}
+
+inline __m128i identifierMask(__m128i v) {
+    __m128i letters = inRange(_mm_or_si128(v, _mm_set1_epi8(0x20)), 'a', 26);
+    __m128i digits = inRange(v, '0', 10);
+    __m128i underscore = _mm_cmpeq_epi8(v, _mm_set1_epi8('_'));
+    return _mm_or_si128(_mm_or_si128(letters, digits), underscore);
+}
+
+const char* whitespaceSse2(const char* p, const char* end, size_t& newlines, const char*& lineStart) {
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i space = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), inRange(v, '\t', 5));
+        unsigned stop = ~static_cast<unsigned>(_mm_movemask_epi8(space)) & 0xFFFFu;
+        unsigned lines = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n'))));
+        countLines(p, lines, stop, newlines, lineStart);
+        if (stop) return p + lowestBit(stop);
+        p += 16;
+    }
+    return whitespaceScalar(p, end, newlines, lineStart);
+}
+
+const char* identifierSse2(const char* p, const char* end) {
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        unsigned stop = ~static_cast<unsigned>(_mm_movemask_epi8(identifierMask(v))) & 0xFFFFu;
+        if (stop) return p + lowestBit(stop);
+        p += 16;
+    }
+    return identifierScalar(p, end);
+}
+
+const char* digitsSse2(const char* p, const char* end) {
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        unsigned stop = ~static_cast<unsigned>(_mm_movemask_epi8(inRange(v, '0', 10))) & 0xFFFFu;
+        if (stop) return p + lowestBit(stop);
+        p += 16;
+    }
+    return digitsScalar(p, end);
+}
+
+const ScanFunctions SSE2_SCANS = {whitespaceSse2, identifierSse2, digitsSse2};
+
+SCERSE_TARGET_AVX2 inline __m256i inRange(__m256i v, int first, int count) {
+    __m256i shifted = _mm256_add_epi8(v, _mm256_set1_epi8(static_cast<char>(0x80 - first)));
+    return _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(-128 + count)), shifted);
+}
+
+SCERSE_TARGET_AVX2 inline __m256i identifierMask(__m256i v) {
+    __m256i letters = inRange(_mm256_or_si256(v, _mm256_set1_epi8(0x20)), 'a', 26);
+    __m256i digits = inRange(v, '0', 10);
+    __m256i underscore = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('_'));
+    return _mm256_or_si256(_mm256_or_si256(letters, digits), underscore);
+}
+
+SCERSE_TARGET_AVX2
+const char* whitespaceAvx2(const char* p, const char* end, size_t& newlines, const char*& lineStart) {
+    while (end - p >= 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i space = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')), inRange(v, '\t', 5));
+        unsigned stop = ~static_cast<unsigned>(_mm256_movemask_epi8(space));
+        unsigned lines = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n'))));
+        countLines(p, lines, stop, newlines, lineStart);
+        if (stop) return p + lowestBit(stop);
+        p += 32;
+    }
+    return whitespaceSse2(p, end, newlines, lineStart);
+}
+
+SCERSE_TARGET_AVX2
+const char* identifierAvx2(const char* p, const char* end) {
+    while (end - p >= 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        unsigned stop = ~static_cast<unsigned>(_mm256_movemask_epi8(identifierMask(v)));
+        if (stop) return p + lowestBit(stop);
+        p += 32;
+    }
+    return identifierSse2(p, end);
+}
+
+SCERSE_TARGET_AVX2
+const char* digitsAvx2(const char* p, const char* end) {
+    while (end - p >= 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        unsigned stop = ~static_cast<unsigned>(_mm256_movemask_epi8(inRange(v, '0', 10)));
+        if (stop) return p + lowestBit(stop);
+        p += 32;
+    }
+    return digitsSse2(p, end);
+}
+
+const ScanFunctions AVX2_SCANS = {whitespaceAvx2, identifierAvx2, digitsAvx2};
+
+bool cpuHasAvx2() {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    // AVX state must also be enabled by the OS (OSXSAVE + XCR0)
+    __cpuid(info, 1);
+    if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0) return false;
+    if ((_xgetbv(0) & 6) != 6) return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+#endif // SCERSE_SCAN_X86
+
+const ScanFunctions& functionsFor(ScanKernel kernel) {
+    switch (kernel) {
+#ifdef SCERSE_SCAN_X86
+        case ScanKernel::AVX2: return AVX2_SCANS;
+        case ScanKernel::SSE2: return SSE2_SCANS;
+#endif
+        default:               return SCALAR_SCANS;
+    }
+}
+
+std::atomic<ScanKernel>& selectedKernel() {
+    static std::atomic<ScanKernel> kernel(bestScanKernel());
+    return kernel;
+}
+
+} // namespace
+
+ScanKernel bestScanKernel() {
+#ifdef SCERSE_SCAN_X86
+    // SSE2 is part of x86-64; only AVX2 needs asking
+    static const ScanKernel best = cpuHasAvx2() ? ScanKernel::AVX2 : ScanKernel::SSE2;
+    return best;
+#else
+    return ScanKernel::SCALAR;
+#endif
+}
+
+bool setScanKernel(ScanKernel kernel) {
+    if (static_cast<int>(kernel) > static_cast<int>(bestScanKernel())) return false;
+    selectedKernel().store(kernel, std::memory_order_relaxed);
+    return true;
+}
+
+ScanKernel currentScanKernel() {
+    return selectedKernel().load(std::memory_order_relaxed);
+}
+
+const ScanFunctions& scanFunctions() {
+    return functionsFor(currentScanKernel());
+}
+
+} // namespace SCERSE
@@ -0,0 +1,60 @@
+#pragma once
+#include <cstddef>
+
+namespace SCERSE {
+
+/**
+ * ScanKernel
+ * Instruction set behind the Lexer's bulk character-class scans
+ */
+enum class ScanKernel { SCALAR, SSE2, AVX2 };
+
+inline const char* to_cstring(ScanKernel kernel) {
+    switch (kernel) {
+        case ScanKernel::SCALAR: return "scalar";
+        case ScanKernel::SSE2:   return "SSE2";
+        case ScanKernel::AVX2:   return "AVX2";
+        default:                 return "unknown";
+    }
+}
+
+/**
+ * ScanFunctions
+ * Each scan starts at 'p' and returns the first byte in [p, end) outside
+ * its class (or 'end'). The SIMD kernels classify 16 or 32 bytes per
+ * step and finish the last partial block byte by byte, so they never
+ * read past 'end'.
+ */
+struct ScanFunctions {
+    // ' ', '\t', '\n', '\v', '\f', '\r'. 'newlines' is increased by the
+    // number of '\n' in the run and 'lineStart' set to the byte after the
+    // last of them (left alone if there is none).
+    const char* (*whitespace)(const char* p, const char* end, size_t& newlines, const char*& lineStart);
+
+    // [A-Za-z0-9_]
+    const char* (*identifier)(const char* p, const char* end);
+
+    // [0-9]
+    const char* (*digits)(const char* p, const char* end);
+};
+
+/**
+ * Scans of the selected kernel; the best one the CPU supports unless
+ * setScanKernel() chose another
+ */
+const ScanFunctions& scanFunctions();
+
+/**
+ * Widest kernel this CPU (and build) supports
+ */
+ScanKernel bestScanKernel();
+
+/**
+ * Select the kernel for Lexers created from now on; false (and no change)
+ * if the CPU does not support it. Meant for benchmarks and tests - every
+ * kernel gives the same tokens.
+ */
+bool setScanKernel(ScanKernel kernel);
+ScanKernel currentScanKernel();
+
+} // namespace SCERSE
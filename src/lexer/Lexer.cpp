@@ -1,175 +1,81 @@
-#include "Lexer.hpp"
-#include <cctype>
-#include <unordered_map>
-
-namespace SCERSE {
-
-Lexer::Lexer(const std::string& src)
-    : source(src), index(0), currentPosition(1, 1) {
-    currentChar = index < source.size() ? source[index] : '\0';
-}
-
-void Lexer::advance() {
-    if (currentChar == '\n') {
-        currentPosition.line++;
-        currentPosition.column = 1;
-    } else {
-        currentPosition.column++;
-    }
-
-    index++;
-    currentChar = index < source.size() ? source[index] : '\0';
-}
-
-void Lexer::skipWhitespace() {
-    while (currentChar == ' ' || currentChar == '\t' || currentChar == '\r' || currentChar == '\n') {
-        advance();
-    }
-}
-
-Token Lexer::makeIdentifierOrKeyword() {
-    Position startPos = currentPosition;
-    std::string lexeme;
-
-    while (std::isalnum(currentChar) || currentChar == '_') {
-        lexeme += currentChar;
-        advance();
-    }
-
-    static const std::unordered_map<std::string, TokenType> keywords = {
-        {"var", TokenType::VAR},
-        {"int", TokenType::INT},
-        {"float", TokenType::FLOAT_KW},
-        {"bool", TokenType::BOOL},
-        {"string", TokenType::STRING_KW},
-        {"if", TokenType::IF},
-        {"else", TokenType::ELSE},
-        {"while", TokenType::WHILE},
-        {"for", TokenType::FOR},
-        {"function", TokenType::FUNCTION},
-        {"return", TokenType::RETURN},
-        {"const", TokenType::CONST},
-        {"true", TokenType::TRUE},
-        {"false", TokenType::FALSE},
-        {"void", TokenType::VOID}
-    };
-
-    auto it = keywords.find(lexeme);
-    if (it != keywords.end())
-        return Token(it->second, lexeme, startPos);
-
-    return Token(TokenType::IDENTIFIER, lexeme, startPos);
-}
-
-Token Lexer::makeNumber() {
-    Position startPos = currentPosition;
-    std::string lexeme;
-    bool isFloat = false;
-
-    while (std::isdigit(currentChar)) {
-        lexeme += currentChar;
-        advance();
-    }
-
-    if (currentChar == '.') {
-        isFloat = true;
-        lexeme += currentChar;
-        advance();
-        while (std::isdigit(currentChar)) {
-            lexeme += currentChar;
-            advance();
-        }
-    }
-
-    if (isFloat)
-        return Token(TokenType::FLOAT, lexeme, startPos);
-    else
-        return Token(TokenType::INTEGER, lexeme, startPos);
-}
-
-Token Lexer::makeOperatorOrPunctuation() {
-    Position pos = currentPosition;
-    char ch = currentChar;
-
-    switch (ch) {
-        case ';': advance(); return Token(TokenType::SEMICOLON, ";", pos);
-        case '(': advance(); return Token(TokenType::LEFT_PAREN, "(", pos);
-        case ')': advance(); return Token(TokenType::RIGHT_PAREN, ")", pos);
-        case '{': advance(); return Token(TokenType::LEFT_BRACE, "{", pos);
-        case '}': advance(); return Token(TokenType::RIGHT_BRACE, "}", pos);
-        case '+': advance(); return Token(TokenType::PLUS, "+", pos);
-        case '-': advance(); return Token(TokenType::MINUS, "-", pos);
-        case '*': advance(); return Token(TokenType::MULTIPLY, "*", pos);
-        case '/': advance(); return Token(TokenType::DIVIDE, "/", pos);
-        case '%': advance(); return Token(TokenType::MODULO, "%", pos);
-
-        case '=':
-            advance();
-            if (currentChar == '=') { advance(); return Token(TokenType::EQUAL, "==", pos); }
-            return Token(TokenType::ASSIGN, "=", pos);
-
-        case '<':
-            advance();
-            if (currentChar == '=') { advance(); return Token(TokenType::LESS_EQUAL, "<=", pos); }
-            return Token(TokenType::LESS, "<", pos);
-
-        case '>':
-            advance();
-            if (currentChar == '=') { advance(); return Token(TokenType::GREATER_EQUAL, ">=", pos); }
-            return Token(TokenType::GREATER, ">", pos);
-
-        case '!':
-            advance();
-            if (currentChar == '=') { advance(); return Token(TokenType::NOT_EQUAL, "!=", pos); }
-            return Token(TokenType::LOGICAL_NOT, "!", pos);
-
-        case '&':
-            advance();
-            if (currentChar == '&') { advance(); return Token(TokenType::LOGICAL_AND, "&&", pos); }
-            break;
-
-        case '|':
-            advance();
-            if (currentChar == '|') { advance(); return Token(TokenType::LOGICAL_OR, "||", pos); }
-            break;
-
-        case ',': advance(); return Token(TokenType::COMMA, ",", pos);
-        case '.': advance(); return Token(TokenType::DOT, ".", pos);
-    }
-
-    // Unknown character
-    advance();
-    return Token(TokenType::ERROR_TOKEN, "Unexpected character: " + std::string(1, ch), pos);
-}
-
-Token Lexer::getNextToken() {
-    while (isspace(currentChar)) {
-        skipWhitespace();
-    }
-
-    if (currentChar == '\0')
-        return Token(TokenType::EOF_TOKEN, "$", currentPosition);
-
-    if (std::isalpha(currentChar) || currentChar == '_')
-        return makeIdentifierOrKeyword();
-
-    if (std::isdigit(currentChar))
-        return makeNumber();
-
-    return makeOperatorOrPunctuation();
-}
-
-std::vector<Token> Lexer::tokenize() {
-    std::vector<Token> tokens;
-    Token token = getNextToken();
-
-    while (token.type != TokenType::EOF_TOKEN && token.type != TokenType::ERROR_TOKEN) {
-        tokens.push_back(token);
-        token = getNextToken();
-    }
-
-    tokens.push_back(Token(TokenType::EOF_TOKEN, "$", currentPosition));
-    return tokens;
-}
-
-} // namespace SCERSE
+#include "Lexer.hpp"
+
+namespace SCERSE {
+
+Lexer::Lexer(std::string_view src)
+    : source(src), index(0), currentPosition(1, 1), scan(scanFunctions()), dfa(TokenDfa::shared()) {
+    currentChar = index < source.size() ? source[index] : '\0';
+}
+
+Lexer::Lexer(std::string_view src, size_t offset, const Position& start)
+    : source(src), index(offset), currentPosition(start), scan(scanFunctions()), dfa(TokenDfa::shared()) {
+    currentChar = index < source.size() ? source[index] : '\0';
+}
+
+void Lexer::advanceBy(size_t count) {
+    currentPosition.column += static_cast<int>(count);
+    index += count;
+    currentChar = index < source.size() ? source[index] : '\0';
+}
+
+void Lexer::skipWhitespace() {
+    const char* begin = source.data() + index;
+    size_t newlines = 0;
+    const char* lineStart = nullptr;
+    const char* end = scan.whitespace(begin, source.data() + source.size(), newlines, lineStart);
+
+    if (newlines > 0) {
+        currentPosition.line += static_cast<int>(newlines);
+        currentPosition.column = 1 + static_cast<int>(end - lineStart);
+    } else {
+        currentPosition.column += static_cast<int>(end - begin);
+    }
+    index = static_cast<size_t>(end - source.data());
+    currentChar = index < source.size() ? source[index] : '\0';
+}
+
+Token Lexer::getNextToken() {
+    for (;;) {
+        // Tokens often follow each other directly; only a run is worth a scan
+        if (currentChar == ' ' || (currentChar >= '\t' && currentChar <= '\r'))
+            skipWhitespace();
+
+        // The source has an explicit length; a NUL inside it is an
+        // unknown character like any other
+        if (index >= source.size())
+            return Token(TokenType::EOF_TOKEN, "$", currentPosition);
+
+        Position pos = currentPosition;
+        const char* begin = source.data() + index;
+        TokenDfa::Match match = dfa.match(begin, source.data() + source.size(), scan);
+
+        // An unknown character is the lexeme of its ERROR_TOKEN
+        if (match.length == 0) {
+            advanceBy(1);
+            return Token(TokenType::ERROR_TOKEN, std::string_view(begin, 1), pos);
+        }
+
+        // No token spans a newline, so the column is all that moves
+        advanceBy(match.length);
+        if (match.type != TokenType::COMMENT)
+            return Token(match.type, std::string_view(begin, match.length), pos);
+    }
+}
+
+std::vector<Token> Lexer::tokenize() {
+    std::vector<Token> tokens;
+    // Typical source has a token every 4-6 bytes; regrowing from empty
+    // would move every token several times
+    tokens.reserve((source.size() - index) / 6 + 1);
+    Token token = getNextToken();
+
+    while (token.type != TokenType::EOF_TOKEN && token.type != TokenType::ERROR_TOKEN) {
+        tokens.push_back(std::move(token));
+        token = getNextToken();
+    }
+
+    tokens.push_back(Token(TokenType::EOF_TOKEN, "$", currentPosition));
+    return tokens;
+}
+
+} // namespace SCERSE
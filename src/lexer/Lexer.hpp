@@ -1,27 +1,41 @@
-#pragma once
-#include <string>
-#include <vector>
-#include "Token.hpp"
-
-namespace SCERSE {
-
-class Lexer {
-private:
-    std::string source;
-    size_t index;
-    char currentChar;
-    Position currentPosition;
-
-    void advance();
-    void skipWhitespace();
-    Token makeIdentifierOrKeyword();
-    Token makeNumber();
-    Token makeOperatorOrPunctuation();
-
-public:
-    Lexer(const std::string& src);
-    Token getNextToken();
-    std::vector<Token> tokenize();
-};
-
-} // namespace SCERSE
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Token.hpp"
+#include "CharScan.hpp"
+#include "TokenDfa.hpp"
+
+namespace SCERSE {
+
+class Lexer {
+private:
+    std::string_view source;
+    size_t index;
+    char currentChar;
+    Position currentPosition;
+    const ScanFunctions& scan;   // kernel selected when the Lexer was made
+    const TokenDfa& dfa;         // recognizes every token kind of tokenRules()
+
+    void advanceBy(size_t count);   // within one line
+    void skipWhitespace();
+
+public:
+    // src is not copied: tokens view it, so it must outlive the Lexer and
+    // every token it returns (temporaries are rejected for that reason)
+    explicit Lexer(std::string_view src);
+
+    // Start at src[offset], which is known to be at 'start' (a token boundary)
+    Lexer(std::string_view src, size_t offset, const Position& start);
+
+    explicit Lexer(const char* src) : Lexer(std::string_view(src)) {}
+    explicit Lexer(std::string&&) = delete;
+    Lexer(std::string&&, size_t, const Position&) = delete;
+    Token getNextToken();
+    std::vector<Token> tokenize();
+
+    // Current read position (tokenize() puts its EOF here)
+    const Position& getPosition() const { return currentPosition; }
+};
+
+} // namespace SCERSE
@@ -0,0 +1,175 @@
+#include "TokenBuffer.hpp"
+#include "Lexer.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+
+namespace SCERSE {
+
+namespace {
+
+size_t offsetIn(const std::vector<size_t>& lineStarts, const Token& token) {
+    return lineStarts[token.position.line - 1] + token.position.column - 1;
+}
+
+// 1-based line containing 'offset'
+int lineAt(const std::vector<size_t>& lineStarts, size_t offset) {
+    return static_cast<int>(std::upper_bound(lineStarts.begin(), lineStarts.end(), offset) - lineStarts.begin());
+}
+
+int countNewlines(const char* first, const char* last) {
+    return static_cast<int>(std::count(first, last, '\n'));
+}
+
+} // namespace
+
+void TokenBuffer::computeLineStarts() {
+    lineStarts.assign(1, 0);
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == '\n') lineStarts.push_back(i + 1);
+    }
+}
+
+TokenDiff TokenBuffer::reset(const std::string& newText) {
+    const size_t oldCount = tokens.size();
+    text = newText;
+    computeLineStarts();
+    Lexer lexer(text);
+    tokens = lexer.tokenize();
+
+    TokenDiff diff;
+    diff.removed = oldCount;
+    diff.inserted = tokens.size();
+    diff.full = true;
+    return diff;
+}
+
+TokenDiff TokenBuffer::update(const std::string& newText) {
+    size_t prefix = 0;
+    const size_t shorter = std::min(text.size(), newText.size());
+    while (prefix < shorter && text[prefix] == newText[prefix]) ++prefix;
+    size_t suffix = 0;
+    while (suffix < shorter - prefix &&
+           text[text.size() - 1 - suffix] == newText[newText.size() - 1 - suffix]) {
+        ++suffix;
+    }
+    if (prefix == text.size() && prefix == newText.size() && !tokens.empty()) {
+        TokenDiff diff;
+        diff.first = tokens.size();
+        return diff;
+    }
+
+    TextEdit edit;
+    edit.offset = prefix;
+    edit.removed = text.size() - prefix - suffix;
+    edit.inserted = newText.substr(prefix, newText.size() - prefix - suffix);
+    return applyEdit(edit);
+}
+
+TokenDiff TokenBuffer::applyEdit(const TextEdit& edit) {
+    if (tokens.empty() || edit.offset > text.size() || edit.removed > text.size() - edit.offset) {
+        std::string edited = text;
+        if (edit.offset <= edited.size()) {
+            edited.replace(edit.offset, edit.removed, edit.inserted);
+        }
+        return reset(edited);
+    }
+
+    // ---- Text and line table ----
+    const size_t editEnd = edit.offset + edit.removed;
+    const int lastEditedLine = lineAt(lineStarts, editEnd);
+    const int lineDelta = countNewlines(edit.inserted.data(), edit.inserted.data() + edit.inserted.size()) -
+                          countNewlines(text.data() + edit.offset, text.data() + editEnd);
+    const int64_t shift = static_cast<int64_t>(edit.inserted.size()) - static_cast<int64_t>(edit.removed);
+
+    std::vector<size_t> oldLineStarts = lineStarts;
+    text.replace(edit.offset, edit.removed, edit.inserted);
+    {
+        auto first = std::upper_bound(lineStarts.begin(), lineStarts.end(), edit.offset);
+        auto last = std::upper_bound(first, lineStarts.end(), editEnd);
+        for (auto it = last; it != lineStarts.end(); ++it) *it = static_cast<size_t>(*it + shift);
+        first = lineStarts.erase(first, last);
+        std::vector<size_t> added;
+        for (size_t i = 0; i < edit.inserted.size(); ++i) {
+            if (edit.inserted[i] == '\n') added.push_back(edit.offset + i + 1);
+        }
+        lineStarts.insert(first, added.begin(), added.end());
+    }
+
+    // ---- Relex from the token before the edit until back in step ----
+    const size_t oldCount = tokens.size();
+    auto endsBefore = [&](const Token& token, size_t offset) {
+        return offsetIn(oldLineStarts, token) + token.lexeme.size() < offset;
+    };
+    size_t first = std::lower_bound(tokens.begin(), tokens.end() - 1, edit.offset, endsBefore) - tokens.begin();
+    if (first > 0) --first;
+
+    size_t startOffset = 0;
+    Position startPosition(1, 1);
+    if (first > 0) {
+        startOffset = offsetIn(oldLineStarts, tokens[first]);
+        startPosition = tokens[first].position;
+    }
+
+    const size_t newEditEnd = edit.offset + edit.inserted.size();
+    const int lastEditedLineNew = lastEditedLine + lineDelta;
+    std::vector<Token> relexed;
+    size_t resume = oldCount;   // old index where the reused tail starts
+    Lexer lexer(text, startOffset, startPosition);
+    for (;;) {
+        Token token = lexer.getNextToken();
+        if (token.type == TokenType::ERROR_TOKEN) {
+            relexed.push_back(Token(TokenType::EOF_TOKEN, "$", lexer.getPosition()));
+            break;
+        }
+        if (token.type == TokenType::EOF_TOKEN) {
+            relexed.push_back(token);
+            break;
+        }
+
+        const size_t offset = offsetIn(lineStarts, token);
+        if (offset >= newEditEnd && token.position.line > lastEditedLineNew) {
+            const size_t oldOffset = static_cast<size_t>(static_cast<int64_t>(offset) - shift);
+            auto at = std::lower_bound(tokens.begin() + first, tokens.end() - 1, oldOffset,
+                                       [&](const Token& t, size_t o) { return offsetIn(oldLineStarts, t) < o; });
+            // The old token's view is stale, but the bytes from here on are
+            // unchanged, so type and length identify it
+            if (at != tokens.end() - 1 && offsetIn(oldLineStarts, *at) == oldOffset &&
+                at->type == token.type && at->lexeme.size() == token.lexeme.size()) {
+                resume = at - tokens.begin();
+                break;
+            }
+        }
+        relexed.push_back(std::move(token));
+    }
+
+    const size_t tailStart = first + relexed.size();
+    if (relexed.size() == resume - first) {
+        std::move(relexed.begin(), relexed.end(), tokens.begin() + first);
+    } else {
+        tokens.erase(tokens.begin() + first, tokens.begin() + resume);
+        tokens.insert(tokens.begin() + first,
+                      std::make_move_iterator(relexed.begin()), std::make_move_iterator(relexed.end()));
+    }
+    if (lineDelta != 0) {
+        for (size_t i = tailStart; i < tokens.size(); ++i) tokens[i].position.line += lineDelta;
+    }
+
+    // Reused tokens still view the text before the edit, which the replace
+    // may have moved; point them at the same bytes of the new text
+    auto rebase = [&](Token& token) {
+        token.lexeme = std::string_view(text.data() + offsetIn(lineStarts, token), token.lexeme.size());
+    };
+    for (size_t i = 0; i < first; ++i) rebase(tokens[i]);
+    for (size_t i = tailStart; i + 1 < tokens.size(); ++i) rebase(tokens[i]);
+
+    TokenDiff diff;
+    diff.first = first;
+    diff.removed = resume - first;
+    diff.inserted = relexed.size();
+    diff.lineDelta = lineDelta;
+    diff.lastEditedLine = lastEditedLine;
+    return diff;
+}
+
+} // namespace SCERSE
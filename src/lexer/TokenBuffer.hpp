@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "Token.hpp"
+
+namespace SCERSE {
+
+/**
+ * TextEdit
+ * Replace 'removed' bytes at 'offset' with 'inserted'
+ */
+struct TextEdit {
+    size_t offset = 0;
+    size_t removed = 0;
+    std::string inserted;
+};
+
+/**
+ * TokenDiff
+ * What an update did to a TokenBuffer's tokens: old tokens
+ * [first, first + removed) were replaced by new tokens
+ * [first, first + inserted). Tokens before 'first' are unchanged; the ones
+ * after the range are the old tail, moved by inserted - removed places and
+ * by lineDelta lines. If 'full' is set the whole text was lexed again and
+ * the range covers every token.
+ */
+struct TokenDiff {
+    size_t first = 0;
+    size_t removed = 0;
+    size_t inserted = 0;
+    int lineDelta = 0;
+    int lastEditedLine = 0;   // old lines after this one moved by lineDelta
+    bool full = false;
+
+    // An edit before the first token (say, to a leading comment) can move
+    // every token to another line without replacing any
+    bool unchanged() const { return !full && removed == 0 && inserted == 0 && lineDelta == 0; }
+};
+
+/**
+ * TokenBuffer
+ * The text and tokens of one document, kept up to date edit by edit.
+ *
+ * An edit is lexed again from the last token boundary before it; lexing
+ * stops as soon as a new token lines up with an old one past the edit, and
+ * the old tokens from there on are kept with their positions shifted.
+ * Tokens view the buffer's own copy of the text. The tokens are always
+ * those of Lexer(getText()).tokenize().
+ */
+class TokenBuffer {
+public:
+    TokenBuffer() = default;
+    TokenBuffer(const TokenBuffer&) = delete;
+    TokenBuffer& operator=(const TokenBuffer&) = delete;
+
+    /**
+     * Take 'text' and lex all of it
+     */
+    TokenDiff reset(const std::string& text);
+
+    /**
+     * Apply one edit to the text and relex what it touched. An edit outside
+     * the text (or before the first reset()) lexes everything again.
+     */
+    TokenDiff applyEdit(const TextEdit& edit);
+
+    /**
+     * Replace the whole text; the changed span is found by comparing with
+     * the current text. Nothing is relexed if the text is the same.
+     */
+    TokenDiff update(const std::string& text);
+
+    const std::vector<Token>& getTokens() const { return tokens; }
+    const std::string& getText() const { return text; }
+
+private:
+    std::string text;
+    std::vector<size_t> lineStarts;   // offset of every line
+    std::vector<Token> tokens;
+
+    void computeLineStarts();
+};
+
+} // namespace SCERSE
@@ -0,0 +1,372 @@
+#include "TokenDfa.hpp"
+#include <algorithm>
+#include <bitset>
+#include <iostream>
+#include <map>
+#include <string>
+
+namespace SCERSE {
+
+namespace {
+
+using ByteSet = std::bitset<256>;
+
+// Thompson NFA: every state has at most one byte edge plus ε edges
+struct NfaState {
+    std::vector<int> epsilon;
+    ByteSet bytes;
+    int target = -1;   // reached on 'bytes'
+    int rule = -1;     // accepting for this rule index
+};
+
+struct Fragment {
+    int start;
+    int end;   // no edges yet
+};
+
+class Nfa {
+public:
+    std::vector<NfaState> states;
+
+    int add() {
+        states.emplace_back();
+        return static_cast<int>(states.size() - 1);
+    }
+
+    /**
+     * Fragment for 'pattern'; false (with 'error' set) if it is malformed
+     */
+    bool compile(const char* pattern, Fragment& out, std::string& error) {
+        text = pattern;
+        pos = 0;
+        failure.clear();
+        out = alternation();
+        if (failure.empty() && text[pos] != '\0') failure = "unexpected ')'";
+        error = failure;
+        return failure.empty();
+    }
+
+private:
+    const char* text = "";
+    size_t pos = 0;
+    std::string failure;
+
+    Fragment bytes(const ByteSet& set) {
+        Fragment f{add(), add()};
+        states[f.start].bytes = set;
+        states[f.start].target = f.end;
+        return f;
+    }
+
+    Fragment empty() {
+        int s = add();
+        return Fragment{s, s};
+    }
+
+    Fragment alternation() {
+        Fragment left = sequence();
+        while (failure.empty() && text[pos] == '|') {
+            ++pos;
+            Fragment right = sequence();
+            Fragment f{add(), add()};
+            states[f.start].epsilon = {left.start, right.start};
+            states[left.end].epsilon.push_back(f.end);
+            states[right.end].epsilon.push_back(f.end);
+            left = f;
+        }
+        return left;
+    }
+
+    Fragment sequence() {
+        Fragment result = empty();
+        while (failure.empty() && text[pos] != '\0' && text[pos] != '|' && text[pos] != ')') {
+            Fragment next = repeat();
+            states[result.end].epsilon.push_back(next.start);
+            result.end = next.end;
+        }
+        return result;
+    }
+
+    Fragment repeat() {
+        Fragment inner = atom();
+        while (failure.empty() && (text[pos] == '*' || text[pos] == '+' || text[pos] == '?')) {
+            const char op = text[pos++];
+            Fragment f{add(), add()};
+            states[f.start].epsilon.push_back(inner.start);
+            states[inner.end].epsilon.push_back(f.end);
+            if (op != '+') states[f.start].epsilon.push_back(f.end);
+            if (op != '?') states[inner.end].epsilon.push_back(inner.start);
+            inner = f;
+        }
+        return inner;
+    }
+
+    Fragment atom() {
+        const char c = text[pos];
+        if (c == '(') {
+            ++pos;
+            Fragment inner = alternation();
+            if (failure.empty() && text[pos++] != ')') failure = "missing ')'";
+            return inner;
+        }
+        if (c == '[') return bytes(byteClass());
+        if (c == '*' || c == '+' || c == '?') {
+            failure = std::string("nothing to repeat before '") + c + "'";
+            return empty();
+        }
+        ++pos;
+        if (c == '.') {
+            ByteSet any;
+            any.set();
+            any.reset('\n');
+            return bytes(any);
+        }
+        ByteSet one;
+        one.set(static_cast<unsigned char>(c == '\\' ? escaped() : c));
+        return bytes(one);
+    }
+
+    // The character after a '\' (pos is past the '\')
+    char escaped() {
+        const char c = text[pos];
+        if (c == '\0') {
+            failure = "'\\' at end of pattern";
+            return c;
+        }
+        ++pos;
+        switch (c) {
+            case 'n': return '\n';
+            case 't': return '\t';
+            case 'r': return '\r';
+            default:  return c;
+        }
+    }
+
+    ByteSet byteClass() {
+        ByteSet set;
+        ++pos;   // '['
+        const bool negate = text[pos] == '^';
+        if (negate) ++pos;
+        while (failure.empty() && text[pos] != ']') {
+            if (text[pos] == '\0') {
+                failure = "missing ']'";
+                break;
+            }
+            char first = text[pos++];
+            if (first == '\\') first = escaped();
+            char last = first;
+            if (text[pos] == '-' && text[pos + 1] != ']' && text[pos + 1] != '\0') {
+                ++pos;
+                last = text[pos++];
+                if (last == '\\') last = escaped();
+            }
+            for (int b = static_cast<unsigned char>(first); b <= static_cast<unsigned char>(last); ++b) {
+                set.set(b);
+            }
+        }
+        ++pos;   // ']'
+        return negate ? ~set : set;
+    }
+};
+
+void closure(const Nfa& nfa, std::vector<int>& set) {
+    std::vector<bool> seen(nfa.states.size(), false);
+    for (int s : set) seen[s] = true;
+    for (size_t i = 0; i < set.size(); ++i) {
+        for (int next : nfa.states[set[i]].epsilon) {
+            if (!seen[next]) {
+                seen[next] = true;
+                set.push_back(next);
+            }
+        }
+    }
+    std::sort(set.begin(), set.end());
+}
+
+} // namespace
+
+const TokenDfa& TokenDfa::shared() {
+    static const TokenDfa dfa(tokenRules());
+    return dfa;
+}
+
+TokenDfa::TokenDfa(const std::vector<TokenRule>& rules) {
+    // Until the build succeeds: one dead row, so match() finds nothing
+    std::fill(std::begin(byteClass), std::end(byteClass), 2);
+    stride = 3;
+    table = {NO_MATCH, RUN_NONE, DEAD};
+
+    // ---- NFA: one fragment per rule under a common start ----
+    Nfa nfa;
+    const int nfaStart = nfa.add();
+    for (size_t r = 0; r < rules.size(); ++r) {
+        Fragment fragment;
+        std::string error;
+        if (!nfa.compile(rules[r].pattern, fragment, error)) {
+            std::cerr << "ERROR: Token pattern \"" << rules[r].pattern << "\" for "
+                      << tokenTypeToString(rules[r].type) << ": " << error << std::endl;
+            return;
+        }
+        nfa.states[nfaStart].epsilon.push_back(fragment.start);
+        nfa.states[fragment.end].rule = static_cast<int>(r);
+    }
+
+    // ---- Byte classes: bytes that are on the same side of every edge ----
+    std::vector<ByteSet> edgeSets;
+    for (const NfaState& state : nfa.states) {
+        if (state.target >= 0) edgeSets.push_back(state.bytes);
+    }
+    std::map<std::vector<bool>, int> classIds;
+    std::vector<int> classOf(256);
+    std::vector<int> representative;
+    for (int b = 0; b < 256; ++b) {
+        std::vector<bool> signature(edgeSets.size());
+        for (size_t e = 0; e < edgeSets.size(); ++e) signature[e] = edgeSets[e].test(b);
+        auto inserted = classIds.emplace(signature, static_cast<int>(representative.size()));
+        if (inserted.second) representative.push_back(b);
+        classOf[b] = inserted.first->second;
+    }
+    const size_t classCount = representative.size();
+
+    // ---- Subset construction; DFA state 0 is the empty (dead) set ----
+    std::vector<std::vector<int>> sets(1);
+    std::map<std::vector<int>, int> setIds{{std::vector<int>(), 0}};
+    std::vector<std::vector<int>> next;
+    std::vector<int> accepts;
+
+    std::vector<int> initial{nfaStart};
+    closure(nfa, initial);
+    setIds.emplace(initial, 1);
+    sets.push_back(initial);
+
+    for (size_t d = 0; d < sets.size(); ++d) {
+        next.emplace_back(classCount, 0);
+        int rule = -1;
+        for (int s : sets[d]) {
+            if (nfa.states[s].rule >= 0 && (rule < 0 || nfa.states[s].rule < rule)) rule = nfa.states[s].rule;
+        }
+        accepts.push_back(rule);
+        if (d == 0) continue;
+
+        for (size_t c = 0; c < classCount; ++c) {
+            std::vector<int> moved;
+            for (int s : sets[d]) {
+                const NfaState& state = nfa.states[s];
+                if (state.target >= 0 && state.bytes.test(representative[c])) moved.push_back(state.target);
+            }
+            if (moved.empty()) continue;
+            closure(nfa, moved);
+            auto found = setIds.emplace(moved, static_cast<int>(sets.size()));
+            if (found.second) sets.push_back(moved);
+            next[d][c] = found.first->second;
+        }
+    }
+    const size_t dfaCount = sets.size();
+
+    // ---- Minimization: refine by accepted rule, then by successors ----
+    std::vector<int> group(dfaCount);
+    size_t groupCount = 0;
+    {
+        std::map<int, int> byRule;
+        for (size_t d = 0; d < dfaCount; ++d) {
+            group[d] = byRule.emplace(accepts[d], static_cast<int>(byRule.size())).first->second;
+        }
+        groupCount = byRule.size();
+    }
+    for (;;) {
+        std::map<std::vector<int>, int> keys;
+        std::vector<int> refined(dfaCount);
+        for (size_t d = 0; d < dfaCount; ++d) {
+            std::vector<int> key(1, group[d]);
+            for (size_t c = 0; c < classCount; ++c) key.push_back(group[next[d][c]]);
+            refined[d] = keys.emplace(key, static_cast<int>(keys.size())).first->second;
+        }
+        group.swap(refined);
+        if (keys.size() == groupCount) break;
+        groupCount = keys.size();
+    }
+
+    // ---- Runs: groups that loop on exactly the bytes of a scan kernel ----
+    ByteSet identifierRun;
+    ByteSet digitRun;
+    for (int b = 0; b < 256; ++b) {
+        digitRun[b] = b >= '0' && b <= '9';
+        identifierRun[b] = digitRun[b] || (b >= 'A' && b <= 'Z') || (b >= 'a' && b <= 'z') || b == '_';
+    }
+    std::vector<uint16_t> runOf(groupCount, RUN_NONE);
+    for (size_t d = 1; d < dfaCount; ++d) {
+        if (group[d] == group[0]) continue;
+        ByteSet loop;
+        for (int b = 0; b < 256; ++b) loop[b] = group[next[d][classOf[b]]] == group[d];
+        if (loop == identifierRun) runOf[group[d]] = RUN_IDENTIFIER;
+        if (loop == digitRun) runOf[group[d]] = RUN_DIGITS;
+    }
+
+    // ---- Rows: the dead state's group is row 0, run rows come last ----
+    std::vector<int> row(groupCount, -1);
+    std::vector<size_t> members(groupCount);
+    int rows = 0;
+    int runRow = 0;
+    row[group[0]] = rows++;
+    members[0] = 0;
+    for (int pass = 0; pass < 2; ++pass) {
+        for (size_t d = 1; d < dfaCount; ++d) {
+            const bool run = runOf[group[d]] != RUN_NONE;
+            if (row[group[d]] >= 0 || run != (pass == 1)) continue;
+            row[group[d]] = rows;
+            members[rows++] = d;
+        }
+        if (pass == 0) runRow = rows;
+    }
+
+    const size_t newStride = classCount + 2;
+    if (static_cast<size_t>(rows) * newStride > NO_MATCH || newStride > 256) {
+        std::cerr << "ERROR: Token DFA has " << rows << " states x " << classCount
+                  << " byte classes, too many for 16-bit offsets" << std::endl;
+        return;
+    }
+
+    std::vector<uint16_t> built(rows * newStride, 0);
+    for (int r = 0; r < rows; ++r) {
+        const size_t d = members[r];
+        built[r * newStride] = accepts[d] >= 0 ? static_cast<uint16_t>(rules[accepts[d]].type) : NO_MATCH;
+        built[r * newStride + 1] = runOf[group[d]];
+        for (size_t c = 0; c < classCount; ++c) {
+            built[r * newStride + 2 + c] = static_cast<uint16_t>(row[group[next[d][c]]] * newStride);
+        }
+    }
+
+    // The Lexer counts lines between tokens only
+    const size_t newline = 2 + classOf['\n'];
+    for (int r = 0; r < rows; ++r) {
+        if (built[r * newStride + newline] != DEAD) {
+            std::cerr << "ERROR: A token pattern can match '\\n'" << std::endl;
+            return;
+        }
+    }
+
+    for (int b = 0; b < 256; ++b) byteClass[b] = static_cast<uint8_t>(2 + classOf[b]);
+    table.swap(built);
+    stride = static_cast<uint32_t>(newStride);
+    start = static_cast<uint32_t>(row[group[1]] * newStride);
+    runStart = runRow < rows ? static_cast<uint32_t>(runRow * newStride) : UINT32_MAX;
+}
+
+TokenDfa::Match TokenDfa::backtrack(const char* p, const char* end, const ScanFunctions& scan) const {
+    const uint16_t* rows = table.data();
+    uint32_t state = start;
+    Match best;
+    for (const char* q = p; q < end;) {
+        state = rows[state + byteClass[static_cast<unsigned char>(*q)]];
+        if (state == DEAD) break;
+        ++q;
+        if (state >= runStart) q = runEnd(state, q, end, scan);
+        if (rows[state] != NO_MATCH) {
+            best.type = static_cast<TokenType>(rows[state]);
+            best.length = static_cast<size_t>(q - p);
+        }
+    }
+    return best;
+}
+
+} // namespace SCERSE
@@ -0,0 +1,98 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Token.hpp"
+#include "TokenSpec.hpp"
+#include "CharScan.hpp"
+
+namespace SCERSE {
+
+/**
+ * TokenDfa
+ * Minimized DFA recognizing every rule of a token specification. Bytes
+ * are first mapped to byte classes (bytes no rule tells apart share one),
+ * so a state's row has one entry per class instead of 256.
+ *
+ * Table layout: row r starts at r * stride; entry 0 of a row is the
+ * TokenType the state accepts (NO_MATCH if none), entry 1 its RunKind and
+ * entry 2 + c the offset of the row reached on class c. Row 0 is the dead
+ * state, so the scanning loop is a table load and a compare per byte.
+ *
+ * A state that stays put on exactly [A-Za-z0-9_] or [0-9] (the tail of an
+ * identifier or number) skips the rest of the run with a ScanFunctions
+ * kernel instead, so long names cost no more than with a hand-written
+ * scanner. Those rows come last, so telling them apart takes a compare
+ * rather than a load.
+ */
+class TokenDfa {
+public:
+    struct Match {
+        TokenType type = TokenType::ERROR_TOKEN;
+        size_t length = 0;   // 0: no rule matches at this position
+    };
+
+    /**
+     * DFA for tokenRules(), built on first use
+     */
+    static const TokenDfa& shared();
+
+    /**
+     * Build from 'rules'; an invalid pattern (or a rule that can match
+     * '\n') is reported on std::cerr and leaves the DFA matching nothing
+     */
+    explicit TokenDfa(const std::vector<TokenRule>& rules);
+
+    /**
+     * Longest token starting at p (never reading past end); 'scan' skips
+     * identifier and digit runs
+     */
+    Match match(const char* p, const char* end, const ScanFunctions& scan) const {
+        const uint16_t* rows = table.data();
+        uint32_t state = start;
+        const char* q = p;
+        while (q < end) {
+            const uint32_t next = rows[state + byteClass[static_cast<unsigned char>(*q)]];
+            if (next == DEAD) break;
+            state = next;
+            ++q;
+            if (state >= runStart) q = runEnd(state, q, end, scan);
+        }
+
+        // Nearly always the state the DFA stopped in accepts
+        Match found;
+        if (rows[state] != NO_MATCH) {
+            found.type = static_cast<TokenType>(rows[state]);
+            found.length = static_cast<size_t>(q - p);
+            return found;
+        }
+        return q == p ? found : backtrack(p, end, scan);
+    }
+
+    size_t getStateCount() const { return stride ? table.size() / stride : 0; }
+    size_t getClassCount() const { return stride ? stride - 2 : 0; }
+
+private:
+    static constexpr uint16_t NO_MATCH = 0xFFFF;
+    static constexpr uint32_t DEAD = 0;
+
+    // Bytes a state loops on, when a ScanFunctions kernel covers them
+    enum RunKind : uint16_t { RUN_NONE, RUN_IDENTIFIER, RUN_DIGITS };
+
+    uint8_t byteClass[256] = {};   // column of each byte (2-based)
+    std::vector<uint16_t> table;
+    uint32_t stride = 0;
+    uint32_t start = DEAD;
+    uint32_t runStart = UINT32_MAX;   // rows from here on have a RunKind
+
+    const char* runEnd(uint32_t state, const char* q, const char* end, const ScanFunctions& scan) const {
+        return table[state + 1] == RUN_IDENTIFIER ? scan.identifier(q, end) : scan.digits(q, end);
+    }
+
+    /**
+     * match() for a scan that ran past its last accepting state
+     */
+    Match backtrack(const char* p, const char* end, const ScanFunctions& scan) const;
+};
+
+} // namespace SCERSE
@@ -0,0 +1,60 @@
+#include "TokenSpec.hpp"
+
+namespace SCERSE {
+
+const std::vector<TokenRule>& tokenRules() {
+    static const std::vector<TokenRule> rules = {
+        // Keywords come before IDENTIFIER so that they win the tie. This is
+        // the only keyword list; isKeywordString() reads it as well.
+        {TokenType::IF,            "if"},
+        {TokenType::ELSE,          "else"},
+        {TokenType::WHILE,         "while"},
+        {TokenType::FOR,           "for"},
+        {TokenType::FUNCTION,      "function"},
+        {TokenType::RETURN,        "return"},
+        {TokenType::VAR,           "var"},
+        {TokenType::CONST,         "const"},
+        {TokenType::TRUE,          "true"},
+        {TokenType::FALSE,         "false"},
+        {TokenType::INT,           "int"},
+        {TokenType::FLOAT_KW,      "float"},
+        {TokenType::STRING_KW,     "string"},
+        {TokenType::BOOL,          "bool"},
+        {TokenType::VOID,          "void"},
+
+        {TokenType::IDENTIFIER,    "[A-Za-z_][A-Za-z0-9_]*"},
+        {TokenType::INTEGER,       "[0-9]+"},
+        {TokenType::FLOAT,         R"([0-9]+\.[0-9]*)"},
+        {TokenType::STRING,        R"("([^"\\\n]|\\.)*")"},
+        {TokenType::COMMENT,       R"(//.*)"},
+
+        {TokenType::PLUS,          R"(\+)"},
+        {TokenType::MINUS,         "-"},
+        {TokenType::MULTIPLY,      R"(\*)"},
+        {TokenType::DIVIDE,        "/"},
+        {TokenType::MODULO,        "%"},
+        {TokenType::ASSIGN,        "="},
+        {TokenType::EQUAL,         "=="},
+        {TokenType::NOT_EQUAL,     "!="},
+        {TokenType::LESS,          "<"},
+        {TokenType::LESS_EQUAL,    "<="},
+        {TokenType::GREATER,       ">"},
+        {TokenType::GREATER_EQUAL, ">="},
+        {TokenType::LOGICAL_AND,   "&&"},
+        {TokenType::LOGICAL_OR,    R"(\|\|)"},
+        {TokenType::LOGICAL_NOT,   "!"},
+
+        {TokenType::LEFT_PAREN,    R"(\()"},
+        {TokenType::RIGHT_PAREN,   R"(\))"},
+        {TokenType::LEFT_BRACE,    "{"},
+        {TokenType::RIGHT_BRACE,   "}"},
+        {TokenType::LEFT_BRACKET,  R"(\[)"},
+        {TokenType::RIGHT_BRACKET, R"(\])"},
+        {TokenType::SEMICOLON,     ";"},
+        {TokenType::COMMA,         ","},
+        {TokenType::DOT,           R"(\.)"},
+    };
+    return rules;
+}
+
+} // namespace SCERSE
@@ -0,0 +1,27 @@
+#pragma once
+#include <vector>
+#include "Token.hpp"
+
+namespace SCERSE {
+
+/**
+ * TokenRule
+ * One token kind and the pattern its lexemes match. Patterns use a small
+ * regular expression dialect over bytes: literal characters, '.' (any byte
+ * but '\n'), [a-z_] and [^...] classes, ( ), |, *, + and ?; '\' escapes a
+ * special character and \n, \t, \r name control characters.
+ */
+struct TokenRule {
+    TokenType type;
+    const char* pattern;
+};
+
+/**
+ * The token specification shared by the Lexer and the SyntaxHighlighter
+ * (both run the TokenDfa built from it). The longest match wins; on equal
+ * length the rule listed first does. No rule may match '\n', so a token
+ * never spans lines. COMMENT tokens are skipped by the Lexer.
+ */
+const std::vector<TokenRule>& tokenRules();
+
+} // namespace SCERSE
@@ -1,10 +1,21 @@
-#include <QApplication>
-#include "gui/MainWindow.hpp"
-
-int main(int argc, char *argv[])
-{
-    QApplication app(argc, argv);
-    SCERSE::MainWindow window;
-    window.show();
-    return app.exec();
-}
+#include <QApplication>
+#include <QDir>
+#include <QStandardPaths>
+#include "gui/MainWindow.hpp"
+#include "parser/ParseTable.hpp"
+
+int main(int argc, char *argv[])
+{
+    QApplication app(argc, argv);
+
+    // Map the parse table from the cache instead of rebuilding it every start
+    QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (!cacheDir.isEmpty() && QDir().mkpath(cacheDir)) {
+        SCERSE::ParseTable::setCacheFile(
+            QDir(cacheDir).filePath("parse_table.bin").toStdString());
+    }
+
+    SCERSE::MainWindow window;
+    window.show();
+    return app.exec();
+}
@@ -1,118 +1,290 @@
-#pragma once
-#include <string>
-#include <vector>
-#include <map>
-#include <set>
-#include "../lexer/Token.hpp"
-#include "../common/Types.hpp"
-
-namespace SCERSE {
-
-// Grammar symbols (renamed to avoid conflict with SymbolTable.hpp)
-enum class GrammarSymbolType {
-    TERMINAL,
-    NON_TERMINAL
-};
-
-struct GrammarSymbol {
-    GrammarSymbolType type;
-    std::string name;
-    TokenType tokenType; // For terminals
-
-    GrammarSymbol()
-        : type(GrammarSymbolType::TERMINAL), tokenType(TokenType::EOF_TOKEN) {}
-
-    GrammarSymbol(const std::string& n, TokenType tt)
-        : type(GrammarSymbolType::TERMINAL), name(n), tokenType(tt) {}
-
-    GrammarSymbol(const std::string& n)
-        : type(GrammarSymbolType::NON_TERMINAL), name(n), tokenType(TokenType::EOF_TOKEN) {}
-
-    bool operator<(const GrammarSymbol& other) const {
-    return name < other.name;   // ← Compare name only
-    }
-
-    bool operator==(const GrammarSymbol& other) const {
-    return name == other.name;  // ← Compare name only
-    }
-
-};
-
-// Production rule: LHS -> RHS
-struct Production {
-    GrammarSymbol lhs;
-    std::vector<GrammarSymbol> rhs;
-    int id;
-
-    Production(const GrammarSymbol& l, const std::vector<GrammarSymbol>& r, int i)
-        : lhs(l), rhs(r), id(i) {}
-};
-
-// LR(1) item: [A -> α·β, lookahead]
-struct LR1Item {
-    int productionId;
-    int dotPosition;
-    GrammarSymbol lookahead;
-
-    LR1Item(int pid, int dot, const GrammarSymbol& la)
-        : productionId(pid), dotPosition(dot), lookahead(la) {}
-
-    bool operator<(const LR1Item& other) const {
-        if (productionId != other.productionId)
-            return productionId < other.productionId;
-        if (dotPosition != other.dotPosition)
-            return dotPosition < other.dotPosition;
-        return lookahead < other.lookahead;
-    }
-
-    bool operator==(const LR1Item& other) const {
-        return productionId == other.productionId &&
-               dotPosition == other.dotPosition &&
-               lookahead == other.lookahead;
-    }
-};
-
-struct Action {
-    ActionType type;
-    int value; // State number for SHIFT, production id for REDUCE
-
-    Action() : type(ActionType::ERROR), value(-1) {}
-    Action(ActionType t, int v) : type(t), value(v) {}
-};
-
-class Grammar {
-private:
-    std::vector<Production> productions;
-    GrammarSymbol startSymbol;
-    std::set<GrammarSymbol> terminals;
-    std::set<GrammarSymbol> nonTerminals;
-
-    // FIRST and FOLLOW sets
-    std::map<GrammarSymbol, std::set<GrammarSymbol>> firstSets;
-    std::map<GrammarSymbol, std::set<GrammarSymbol>> followSets;
-
-    void computeFirstSets();
-    void computeFollowSets();
-
-public:
-    Grammar();
-
-    void addProduction(const GrammarSymbol& lhs, const std::vector<GrammarSymbol>& rhs);
-    const std::vector<Production>& getProductions() const { return productions; }
-    const Production& getProduction(int id) const { return productions[id]; }
-    const GrammarSymbol& getStartSymbol() const { return startSymbol; }
-
-    std::set<GrammarSymbol> getFirst(const GrammarSymbol& symbol);
-    std::set<GrammarSymbol> getFirst(const std::vector<GrammarSymbol>& symbols);
-    std::set<GrammarSymbol> getFollow(const GrammarSymbol& symbol);
-
-    bool isTerminal(const GrammarSymbol& symbol) const;
-    bool isNonTerminal(const GrammarSymbol& symbol) const;
-
-    size_t getProductionCount() const 
-    {
-    return productions.size();
-    }
-};
-
-} // namespace SCERSE
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <initializer_list>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#include "../lexer/Token.hpp"
+#include "../common/Types.hpp"
+#include "../common/AST.hpp"
+
+namespace SCERSE {
+
+// Grammar symbols (renamed to avoid conflict with SymbolTable.hpp)
+enum class GrammarSymbolType {
+    TERMINAL,
+    NON_TERMINAL
+};
+
+/**
+ * GrammarSymbol
+ * Terminals and nonterminals are numbered densely (each kind from 0) when
+ * the grammar is built, so the id doubles as the ACTION column (terminals)
+ * or GOTO column (nonterminals). Names live in the Grammar and are only
+ * looked up for diagnostics.
+ */
+struct GrammarSymbol {
+    GrammarSymbolType type;
+    int id;
+    TokenType tokenType; // For terminals
+
+    GrammarSymbol()
+        : type(GrammarSymbolType::TERMINAL), id(-1), tokenType(TokenType::EOF_TOKEN) {}
+
+    GrammarSymbol(GrammarSymbolType t, int i, TokenType tt = TokenType::EOF_TOKEN)
+        : type(t), id(i), tokenType(tt) {}
+
+    bool isTerminal() const { return type == GrammarSymbolType::TERMINAL; }
+
+    bool operator<(const GrammarSymbol& other) const {
+        if (type != other.type) return type < other.type;
+        return id < other.id;
+    }
+
+    bool operator==(const GrammarSymbol& other) const {
+        return type == other.type && id == other.id;
+    }
+
+};
+
+/**
+ * TerminalSet
+ * Fixed-width bitset over terminal ids, used for FIRST/FOLLOW sets and
+ * lookaheads during table construction. A plain value; never allocates.
+ */
+struct TerminalSet {
+    static constexpr int WORDS = 2;
+    static constexpr int CAPACITY = 64 * WORDS;
+
+    uint64_t words[WORDS] = {};
+
+    void set(int terminal) { words[terminal >> 6] |= uint64_t(1) << (terminal & 63); }
+    bool test(int terminal) const { return (words[terminal >> 6] >> (terminal & 63)) & 1; }
+
+    bool any() const {
+        for (uint64_t w : words) if (w) return true;
+        return false;
+    }
+
+    // Union in place
+    void merge(const TerminalSet& other) {
+        for (int i = 0; i < WORDS; ++i) words[i] |= other.words[i];
+    }
+
+    bool operator==(const TerminalSet& other) const {
+        for (int i = 0; i < WORDS; ++i) if (words[i] != other.words[i]) return false;
+        return true;
+    }
+    bool operator!=(const TerminalSet& other) const { return !(*this == other); }
+
+    // Calls f(terminalId) for each member in ascending order
+    template <typename F>
+    void forEach(F f) const {
+        for (int i = 0; i < WORDS; ++i) {
+            for (uint64_t w = words[i]; w; w &= w - 1) {
+                f(i * 64 + lowestBit(w));
+            }
+        }
+    }
+
+private:
+    static int lowestBit(uint64_t w) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, w);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctzll(w);
+#endif
+    }
+};
+
+// Every terminal stands for a distinct TokenType, so this bounds the grammar
+static_assert(TerminalSet::CAPACITY > static_cast<int>(TokenType::ERROR_TOKEN),
+              "TerminalSet is too narrow for the token set");
+
+/**
+ * SemanticAction
+ * What a reduction by a production builds. Declared with each production
+ * in Grammar.cpp and applied by LR1Parser::buildAST(), which looks it up
+ * by production id. Children are numbered by RHS position; a token child
+ * becomes a leaf only if an action keeps it.
+ */
+struct SemanticAction {
+    enum class Kind : uint8_t {
+        PASS,      // the value of child 'child'
+        NODE,      // new 'type' node over the children in 'keep'; its text is child 'text'
+        LEAF,      // the token in child 'child' as a 'type' leaf
+        PREPEND    // child 'item' becomes the first child of the list node in child 'child'
+    };
+
+    Kind kind = Kind::PASS;
+    ASTNodeType type = ASTNodeType::EMPTY;
+    int8_t child = 0;
+    int8_t text = -1;
+    int8_t item = 0;
+    uint32_t keep = 0;   // bit i: child i
+
+    static SemanticAction pass(int child = 0) {
+        SemanticAction action;
+        action.child = static_cast<int8_t>(child);
+        return action;
+    }
+
+    static SemanticAction node(ASTNodeType type, std::initializer_list<int> children = {}, int text = -1) {
+        SemanticAction action;
+        action.kind = Kind::NODE;
+        action.type = type;
+        action.text = static_cast<int8_t>(text);
+        for (int i : children) action.keep |= uint32_t(1) << i;
+        return action;
+    }
+
+    // Operator node: the operator's text, the operands as children
+    static SemanticAction binary() { return node(ASTNodeType::BINARY_OPERATION, {0, 2}, 1); }
+
+    static SemanticAction leaf(ASTNodeType type, int child = 0) {
+        SemanticAction action;
+        action.kind = Kind::LEAF;
+        action.type = type;
+        action.child = static_cast<int8_t>(child);
+        return action;
+    }
+
+    static SemanticAction prepend(int item, int list) {
+        SemanticAction action;
+        action.kind = Kind::PREPEND;
+        action.item = static_cast<int8_t>(item);
+        action.child = static_cast<int8_t>(list);
+        return action;
+    }
+};
+
+// Production rule: LHS -> RHS
+struct Production {
+    GrammarSymbol lhs;
+    std::vector<GrammarSymbol> rhs;
+    int id;
+    SemanticAction action;
+
+    Production(const GrammarSymbol& l, const std::vector<GrammarSymbol>& r, int i,
+               const SemanticAction& a = SemanticAction())
+        : lhs(l), rhs(r), id(i), action(a) {}
+};
+
+// LR(1) item: [A -> α·β, lookahead]; lookahead is a terminal id
+struct LR1Item {
+    int productionId;
+    int dotPosition;
+    int lookahead;
+
+    LR1Item(int pid, int dot, int la)
+        : productionId(pid), dotPosition(dot), lookahead(la) {}
+
+    bool operator<(const LR1Item& other) const {
+        if (productionId != other.productionId)
+            return productionId < other.productionId;
+        if (dotPosition != other.dotPosition)
+            return dotPosition < other.dotPosition;
+        return lookahead < other.lookahead;
+    }
+
+    bool operator==(const LR1Item& other) const {
+        return productionId == other.productionId &&
+               dotPosition == other.dotPosition &&
+               lookahead == other.lookahead;
+    }
+};
+
+struct Action {
+    ActionType type;
+    int value; // State number for SHIFT, production id for REDUCE
+
+    Action() : type(ActionType::ERROR), value(-1) {}
+    Action(ActionType t, int v) : type(t), value(v) {}
+};
+
+class Grammar {
+private:
+    std::vector<Production> productions;
+    GrammarSymbol startSymbol;
+    GrammarSymbol endSymbol;   // "$"
+
+    // Symbol tables, indexed by id
+    std::vector<std::string> terminalNames;
+    std::vector<TokenType> terminalTokens;
+    std::vector<std::string> nonTerminalNames;
+    std::vector<int> tokenToTerminal;               // indexed by TokenType
+    std::vector<std::vector<int>> productionsByLhs; // indexed by nonterminal id
+
+    // Per nonterminal: FIRST without ε, whether it derives ε, and FOLLOW
+    std::vector<TerminalSet> firstSets;
+    std::vector<bool> nullable;
+    std::vector<TerminalSet> followSets;
+
+    GrammarSymbol addTerminal(const std::string& name, TokenType tokenType);
+    GrammarSymbol addNonTerminal(const std::string& name);
+
+    void computeFirstSets();
+    void computeFollowSets();
+
+public:
+    Grammar();
+
+    void addProduction(const GrammarSymbol& lhs, const std::vector<GrammarSymbol>& rhs,
+                       const SemanticAction& action = SemanticAction());
+    const std::vector<Production>& getProductions() const { return productions; }
+    const Production& getProduction(int id) const { return productions[id]; }
+    const GrammarSymbol& getStartSymbol() const { return startSymbol; }
+    const GrammarSymbol& getEndSymbol() const { return endSymbol; }
+
+    size_t getTerminalCount() const { return terminalNames.size(); }
+    size_t getNonTerminalCount() const { return nonTerminalNames.size(); }
+
+    /**
+     * Productions whose left-hand side is the given nonterminal
+     */
+    const std::vector<int>& getProductionsFor(int nonTerminalId) const {
+        return productionsByLhs[nonTerminalId];
+    }
+
+    /**
+     * Terminal id for a token type; -1 if the grammar does not use it
+     */
+    int terminalForToken(TokenType type) const {
+        int t = static_cast<int>(type);
+        return (t >= 0 && t < static_cast<int>(tokenToTerminal.size())) ? tokenToTerminal[t] : -1;
+    }
+
+    // Names are for diagnostics only
+    const std::string& getName(const GrammarSymbol& symbol) const {
+        return symbol.isTerminal() ? terminalNames[symbol.id] : nonTerminalNames[symbol.id];
+    }
+    const std::string& getTerminalName(int terminalId) const { return terminalNames[terminalId]; }
+
+    // FNV-1a hash of the symbols, productions and their node kinds; changes whenever Grammar.cpp does
+    uint64_t getContentHash() const;
+
+    const TerminalSet& getFirst(int nonTerminalId) const { return firstSets[nonTerminalId]; }
+    const TerminalSet& getFollow(int nonTerminalId) const { return followSets[nonTerminalId]; }
+    bool isNullable(int nonTerminalId) const { return nullable[nonTerminalId]; }
+
+    /**
+     * Add FIRST(first..last) to 'out' (ε excluded); returns true if the whole
+     * sequence derives ε, in which case the caller adds its own follow
+     * terminal - e.g. the item lookahead when computing FIRST(βa).
+     */
+    bool firstOfSequence(const GrammarSymbol* first, const GrammarSymbol* last, TerminalSet& out) const;
+
+    bool isTerminal(const GrammarSymbol& symbol) const;
+    bool isNonTerminal(const GrammarSymbol& symbol) const;
+
+    size_t getProductionCount() const 
+    {
+    return productions.size();
+    }
+};
+
+} // namespace SCERSE
@@ -0,0 +1,253 @@
+#include "IncrementalParser.hpp"
+#include <algorithm>
+
+namespace SCERSE {
+
+/**
+ * Records a checkpoint whenever the stack is back to [0, listState...]
+ * and, during an edit, splices the old parse in at the first checkpoint
+ * inside the unchanged tail.
+ */
+class IncrementalParser::Tracker : public ParseHook {
+public:
+    Tracker(IncrementalParser& owner, Previous* previous)
+        : owner(owner), previous(previous),
+          prefix(owner.state.states.size()), lowWater(prefix) {}
+
+    bool beforeAction(ParseState& state, ParseResult& result) override {
+        ++owner.stats.parserActions;
+
+        // Only the top entry can have changed since the last call
+        const std::vector<int>& stack = state.states;
+        if (stack.empty()) return true;
+        prefix = std::min(prefix, stack.size() - 1);
+        if (prefix == stack.size() - 1 &&
+            stack[prefix] == (prefix == 0 ? 0 : owner.listState)) {
+            prefix = stack.size();
+        }
+        lowWater = std::min(lowWater, prefix);
+        if (prefix != stack.size()) return true;
+
+        record(state);
+        if (previous && state.position >= previous->tailStart) splice(state, result);
+        return true;
+    }
+
+private:
+    IncrementalParser& owner;
+    Previous* previous;
+    size_t prefix;     // leading stack entries matching [0, listState...]
+    size_t lowWater;   // smallest prefix since the last checkpoint
+
+    void record(const ParseState& state) {
+        const uint32_t depth = static_cast<uint32_t>(state.states.size() - 1);
+        std::vector<ParseValue>& topValues = owner.topValues;
+        topValues.resize(depth);
+        for (size_t i = lowWater > 0 ? lowWater - 1 : 0; i < depth; ++i) {
+            topValues[i] = state.values[i];
+        }
+        lowWater = state.states.size();
+
+        Checkpoint checkpoint;
+        checkpoint.token = static_cast<uint32_t>(state.position);
+        checkpoint.depth = depth;
+        checkpoint.errorCount = static_cast<uint32_t>(state.errorCount);
+        checkpoint.errorsSize = static_cast<uint32_t>(owner.result.errors.size());
+        std::vector<Checkpoint>& checkpoints = owner.checkpoints;
+        if (!checkpoints.empty() && checkpoints.back().token == checkpoint.token) {
+            checkpoints.back() = checkpoint;
+        } else {
+            checkpoints.push_back(checkpoint);
+        }
+    }
+
+    // From a statement boundary the rest of the parse depends only on the
+    // remaining tokens (the stack below holds nothing but listState), so
+    // the old parse from the matching boundary can be reused up to its
+    // last boundary, just before EOF
+    void splice(ParseState& state, ParseResult& result) {
+        const Previous& old = *previous;
+        if (!old.reachedEnd) {
+            previous = nullptr;
+            return;
+        }
+
+        const int64_t oldToken = static_cast<int64_t>(state.position) - old.tokenDelta;
+        auto match = std::lower_bound(old.checkpoints.begin(), old.checkpoints.end(), oldToken,
+                                      [](const Checkpoint& c, int64_t token) { return c.token < token; });
+        if (match == old.checkpoints.end() || match->token != oldToken) return;
+
+        const Checkpoint& from = *match;
+        const Checkpoint& last = old.checkpoints.back();
+        const int addedErrors = static_cast<int>(last.errorCount - from.errorCount);
+        if (state.errorCount + addedErrors >= LR1Parser::MAX_ERRORS) {
+            previous = nullptr;
+            return;
+        }
+
+        const Checkpoint here = owner.checkpoints.back();
+        for (auto it = match + 1; it != old.checkpoints.end(); ++it) {
+            Checkpoint moved = *it;
+            moved.token = static_cast<uint32_t>(moved.token + old.tokenDelta);
+            moved.depth = moved.depth - from.depth + here.depth;
+            moved.errorCount = moved.errorCount - from.errorCount + here.errorCount;
+            moved.errorsSize = moved.errorsSize - from.errorsSize + here.errorsSize;
+            owner.checkpoints.push_back(moved);
+        }
+
+        for (uint32_t i = from.depth; i < last.depth; ++i) {
+            ParseValue value = old.topValues[i];
+            if (value.token >= 0) value.token = static_cast<int32_t>(value.token + old.tokenDelta);
+            owner.topValues.push_back(value);
+            state.values.push_back(value);
+            state.states.push_back(owner.listState);
+        }
+
+        for (uint32_t i = from.errorsSize; i < last.errorsSize; ++i) {
+            CompilerError error = old.errors[i];
+            if (error.position.line > old.lastEditedLine) error.position.line += old.lineDelta;
+            result.errors.push_back(error);
+        }
+        if (addedErrors > 0) result.success = false;
+
+        state.errorCount += addedErrors;
+        state.position = owner.checkpoints.back().token;
+        prefix = lowWater = state.states.size();
+        previous = nullptr;
+    }
+};
+
+IncrementalParser::IncrementalParser(std::shared_ptr<const ParseTable> table)
+    : parser(std::move(table)) {
+    // Look for a right-recursive list L -> S L that the input starts with
+    // (StmtList -> Stmt StmtList). Its statements leave the stack at
+    // [0, t, t, ...] with t = goto(0, S). Without one every update falls
+    // back to a full parse.
+    const ParseTable& parseTable = parser.getTable();
+    if (parseTable.getStateCount() == 0) return;
+    const Grammar& grammar = parseTable.getGrammar();
+
+    // Nonterminals that can start the input (left corners of the start symbol)
+    std::vector<bool> leftCorner(grammar.getNonTerminalCount(), false);
+    std::vector<int> pending(1, grammar.getStartSymbol().id);
+    leftCorner[grammar.getStartSymbol().id] = true;
+    while (!pending.empty()) {
+        int nt = pending.back();
+        pending.pop_back();
+        for (int id : grammar.getProductionsFor(nt)) {
+            const Production& production = grammar.getProduction(id);
+            if (production.rhs.empty() || production.rhs[0].isTerminal()) continue;
+            if (!leftCorner[production.rhs[0].id]) {
+                leftCorner[production.rhs[0].id] = true;
+                pending.push_back(production.rhs[0].id);
+            }
+        }
+    }
+
+    for (const Production& production : grammar.getProductions()) {
+        if (production.rhs.size() == 2 && !production.rhs[0].isTerminal() &&
+            production.rhs[1] == production.lhs && leftCorner[production.lhs.id]) {
+            listState = parseTable.getGoto(0, production.rhs[0].id);
+            break;
+        }
+    }
+}
+
+const ParseResult& IncrementalParser::reset(const std::string& newText) {
+    return reparse(tokenBuffer.reset(newText));
+}
+
+void IncrementalParser::fullParse() {
+    stats.fullParse = true;
+    result = ParseResult();
+    state = ParseState();
+    checkpoints.clear();
+    topValues.clear();
+    parseFrom(0, nullptr);
+    arenaBaseline = result.ast.size();
+}
+
+void IncrementalParser::parseFrom(size_t checkpoint, Previous* previous) {
+    result.ast.setRoot(NO_NODE);
+    if (checkpoints.empty()) {
+        result.success = true;
+        result.errors.clear();
+        state.states.clear();
+    } else {
+        const Checkpoint& start = checkpoints[checkpoint];
+        checkpoints.resize(checkpoint + 1);
+        topValues.resize(start.depth);
+        result.errors.erase(result.errors.begin() + start.errorsSize, result.errors.end());
+        result.success = start.errorCount == 0;
+
+        state.states.assign(1, 0);
+        state.states.resize(start.depth + 1, listState);
+        state.values = topValues;
+        state.position = start.token;
+        state.errorCount = static_cast<int>(start.errorCount);
+    }
+
+    Tracker tracker(*this, previous);
+    const std::vector<Token>& tokens = tokenBuffer.getTokens();
+    parser.resume(tokens.data(), tokens.size(), state, result, listState >= 0 ? &tracker : nullptr);
+    reachedEnd = !checkpoints.empty() && checkpoints.back().token + 1 == tokens.size();
+}
+
+const ParseResult& IncrementalParser::update(const std::string& newText) {
+    const TokenDiff diff = tokenBuffer.update(newText);
+    if (diff.unchanged()) return result;
+    return reparse(diff);
+}
+
+const ParseResult& IncrementalParser::applyEdit(const TextEdit& edit) {
+    return reparse(tokenBuffer.applyEdit(edit));
+}
+
+const ParseResult& IncrementalParser::reparse(const TokenDiff& diff) {
+    stats = UpdateStats();
+    stats.relexedTokens = diff.inserted;
+    if (diff.full) {
+        fullParse();
+        return result;
+    }
+
+    const size_t first = diff.first;
+    const size_t tailStart = first + diff.inserted;
+    const int64_t tokenDelta = static_cast<int64_t>(diff.inserted) - static_cast<int64_t>(diff.removed);
+    if (diff.lineDelta != 0) {
+        for (NodeId id = 0; id < result.ast.size(); ++id) {
+            ASTNode& node = result.ast[id];
+            if (node.position.line > diff.lastEditedLine) node.position.line += diff.lineDelta;
+        }
+    }
+
+    // Stale nodes from replaced statements stay in the arena until the
+    // next full parse
+    if (listState < 0 || result.ast.size() > 2 * arenaBaseline + 4096) {
+        fullParse();
+        return result;
+    }
+
+    auto before = std::lower_bound(checkpoints.begin(), checkpoints.end(), first,
+                                   [](const Checkpoint& c, size_t token) { return c.token < token; });
+    const size_t start = before == checkpoints.begin() ? 0 : (before - checkpoints.begin()) - 1;
+    if (checkpoints.empty() || checkpoints[start].token >= first) {
+        fullParse();
+        return result;
+    }
+
+    Previous previous;
+    previous.checkpoints.assign(checkpoints.begin() + start, checkpoints.end());
+    previous.topValues = topValues;
+    previous.errors = result.errors;
+    previous.reachedEnd = reachedEnd;
+    previous.tailStart = tailStart;
+    previous.tokenDelta = tokenDelta;
+    previous.lineDelta = diff.lineDelta;
+    previous.lastEditedLine = diff.lastEditedLine;
+
+    parseFrom(start, &previous);
+    return result;
+}
+
+} // namespace SCERSE
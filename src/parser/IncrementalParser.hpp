@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "LR1Parser.hpp"
+#include "../lexer/TokenBuffer.hpp"
+
+namespace SCERSE {
+
+/**
+ * IncrementalParser
+ * Holds the text, tokens and parse of one document and updates them after
+ * an edit instead of starting over.
+ *
+ * The tokens live in a TokenBuffer, which relexes only what an edit
+ * touched and reports the changed token range. Parsing resumes from the last
+ * top-level statement boundary before the edit; once the parser is back
+ * at a statement boundary inside the unchanged tail, the rest of the old
+ * parse (its statements, their AST nodes and its errors) is spliced in
+ * and only the end of input is processed again.
+ *
+ * Results are identical to LR1Parser::parse(Lexer(text).tokenize()).
+ */
+class IncrementalParser {
+public:
+    explicit IncrementalParser(std::shared_ptr<const ParseTable> table = ParseTable::shared());
+
+    /**
+     * Lex and parse 'text' from scratch
+     */
+    const ParseResult& reset(const std::string& text);
+
+    /**
+     * Apply one edit to the current text and update the parse
+     */
+    const ParseResult& applyEdit(const TextEdit& edit);
+
+    /**
+     * Replace the whole text; the changed span is found by comparing with
+     * the current text, so any number of edits can be folded into one call
+     */
+    const ParseResult& update(const std::string& text);
+
+    const ParseResult& getResult() const { return result; }
+    const std::vector<Token>& getTokens() const { return tokenBuffer.getTokens(); }
+    const std::string& getText() const { return tokenBuffer.getText(); }
+
+    // What the last reset/edit had to redo
+    struct UpdateStats {
+        bool fullParse = false;
+        size_t relexedTokens = 0;
+        size_t parserActions = 0;
+    };
+    const UpdateStats& getLastUpdate() const { return stats; }
+
+private:
+    // Statement boundary: the parse stack was [0, listState x depth]
+    struct Checkpoint {
+        uint32_t token;        // index of the next token
+        uint32_t depth;
+        uint32_t errorCount;   // ParseState::errorCount
+        uint32_t errorsSize;   // result.errors.size()
+    };
+
+    // Old parse kept for splicing while an edit is reparsed
+    struct Previous {
+        std::vector<Checkpoint> checkpoints;
+        std::vector<ParseValue> topValues;
+        std::vector<CompilerError> errors;
+        bool reachedEnd = false;
+        size_t tailStart = 0;     // first reused token (new indices)
+        int64_t tokenDelta = 0;   // new index - old index in the tail
+        int lineDelta = 0;
+        int lastEditedLine = 0;   // old lines after this one moved by lineDelta
+    };
+
+    class Tracker;
+
+    LR1Parser parser;
+    int listState = -1;   // goto(0, S) == goto(listState, S) for the statement symbol S
+
+    TokenBuffer tokenBuffer;
+
+    ParseResult result;
+    ParseState state;
+    std::vector<Checkpoint> checkpoints;
+    std::vector<ParseValue> topValues;   // one per statement on the stack
+    bool reachedEnd = false;             // last checkpoint is at the EOF token
+    size_t arenaBaseline = 0;            // AST size after the last full parse
+    UpdateStats stats;
+
+    const ParseResult& reparse(const TokenDiff& diff);
+    void fullParse();
+    void parseFrom(size_t checkpoint, Previous* previous);
+};
+
+} // namespace SCERSE
@@ -1,505 +1,703 @@
-#include "LR1Parser.hpp"
-#include <algorithm>
-#include <iostream>
-
-namespace SCERSE {
-
-// In LR1Parser.cpp constructor
-LR1Parser::LR1Parser() {
-    std::cout << "=== LR1Parser Initialization ===" << std::endl;
-    
-    try {
-        buildParsingTable();
-        
-        std::cout << "✓ States: " << states.size() << std::endl;
-        std::cout << "✓ ACTION entries: " << actionTable.size() << std::endl;
-        std::cout << "✓ GOTO entries: " << gotoTable.size() << std::endl;
-        
-        if (states.empty()) {
-            std::cerr << "WARNING: No parser states generated!" << std::endl;
-        }
-    } catch (const std::exception& ex) {
-        std::cerr << "ERROR building parser table: " << ex.what() << std::endl;
-    }
-    
-    std::cout << "=================================\n" << std::endl;
-}
-
-ParseResult LR1Parser::parse(const std::vector<Token>& tokensIn) {
-    ParseResult result;
-    result.success = true;
-    
-    for (const auto& token : tokensIn) {
-        if (token.type == TokenType::ERROR_TOKEN) {
-            result.success = false;
-            result.errors.push_back(
-                CompilerError(ErrorSeverity::ERROR,
-                              "Unexpected or unknown token: " + token.lexeme,
-                              Position(token.position.line, token.position.column))
-            );
-        }
-    }
-    
-    if (!tokensIn.empty() && tokensIn.back().type != TokenType::EOF_TOKEN) {
-        result.success = false;
-        result.errors.push_back(
-            CompilerError(ErrorSeverity::ERROR,
-                          "Missing end-of-file token",
-                          Position(tokensIn.back().position.line, tokensIn.back().position.column))
-        );
-    }
-    
-    if (states.empty()) {
-        std::cerr << "Warning: Parser states table is empty - skipping syntax analysis\n";
-        return result;
-    }
-    
-    std::stack<int> stateStack;
-    std::stack<std::shared_ptr<ASTNode>> nodeStack;
-    stateStack.push(0);
-    
-    std::vector<Token> tokens = tokensIn;
-    if (tokens.empty() || tokens.back().type != TokenType::EOF_TOKEN) {
-        tokens.push_back(Token{TokenType::EOF_TOKEN, "$", Position()});
-    }
-    
-    size_t idx = 0;
-    int errorCount = 0;
-    const int MAX_ERRORS = 50;
-    
-    while (idx < tokens.size() && errorCount < MAX_ERRORS) {
-        if (stateStack.empty()) {
-            result.errors.push_back(
-                CompilerError(ErrorSeverity::ERROR,
-                              "Parser state stack empty - cannot continue",
-                              Position())
-            );
-            break;
-        }
-        
-        int curState = stateStack.top();
-        const Token& curToken = tokens[idx];
-        GrammarSymbol curSym = tokenToGrammarSymbol(curToken);
-        
-        auto stIt = actionTable.find(curState);
-        if (stIt == actionTable.end()) {
-            result.success = false;
-            result.errors.push_back(
-                CompilerError(ErrorSeverity::ERROR,
-                              "Syntax error near: " + curToken.lexeme,
-                              Position(curToken.position.line, curToken.position.column))
-            );
-            
-            ++idx;
-            ++errorCount;
-            continue;
-        }
-        
-        auto actIt = stIt->second.find(curSym);
-        if (actIt == stIt->second.end()) {
-            result.success = false;
-            result.errors.push_back(
-                CompilerError(ErrorSeverity::ERROR,
-                              "Unexpected token: " + curToken.lexeme,
-                              Position(curToken.position.line, curToken.position.column))
-            );
-            
-            ++idx;
-            ++errorCount;
-            continue;
-        }
-        
-        Action action = actIt->second;
-        
-        switch (action.type) {
-            case ActionType::SHIFT: {
-                stateStack.push(action.value);
-                auto node = std::make_shared<ASTNode>(ASTNodeType::LITERAL, curToken.lexeme);
-                node->position = SourcePosition(curToken.position.line, curToken.position.column);
-                nodeStack.push(node);
-                ++idx;
-                break;
-            }
-            
-            case ActionType::REDUCE: {
-                const auto& prod = grammar.getProduction(action.value);
-                std::vector<std::shared_ptr<ASTNode>> children;
-                
-                for (size_t i = 0; i < prod.rhs.size(); ++i) {
-                    if (!nodeStack.empty()) {
-                        children.insert(children.begin(), nodeStack.top());
-                        nodeStack.pop();
-                    }
-                    if (!stateStack.empty()) stateStack.pop();
-                }
-                
-                auto node = buildAST(children, action.value);
-                nodeStack.push(node);
-                
-                if (!stateStack.empty()) {
-                    int topState = stateStack.top();
-                    auto gotoIt = gotoTable.find(topState);
-                    if (gotoIt != gotoTable.end()) {
-                        auto symbolIt = gotoIt->second.find(prod.lhs);
-                        if (symbolIt != gotoIt->second.end()) {
-                            stateStack.push(symbolIt->second);
-                        } else {
-                            result.success = false;
-                            result.errors.push_back(
-                                CompilerError(ErrorSeverity::ERROR,
-                                              "Parser table missing GOTO entry during reduce",
-                                              Position())
-                            );
-                            ++idx;
-                            ++errorCount;
-                        }
-                    } else {
-                        result.success = false;
-                        result.errors.push_back(
-                            CompilerError(ErrorSeverity::ERROR,
-                                          "Parser table missing GOTO map during reduce",
-                                          Position())
-                        );
-                        ++idx;
-                        ++errorCount;
-                    }
-                }
-                break;
-            }
-            
-            case ActionType::ACCEPT:
-                if (!nodeStack.empty()) result.ast = nodeStack.top();
-                result.success = (errorCount == 0);
-                return result;
-                
-            case ActionType::ERROR:
-            default:
-                result.success = false;
-                result.errors.push_back(
-                    CompilerError(ErrorSeverity::ERROR,
-                                  "Parse error at token: " + curToken.lexeme,
-                                  Position(curToken.position.line, curToken.position.column))
-                );
-                ++idx;
-                ++errorCount;
-                break;
-        }
-    }
-    
-    if (errorCount >= MAX_ERRORS) {
-        result.errors.push_back(
-            CompilerError(ErrorSeverity::ERROR,
-                          "Too many errors - stopping parse",
-                          Position())
-        );
-    }
-    
-    return result;
-}
-
-
-void LR1Parser::buildParsingTable() {
-    states.clear();
-    actionTable.clear();
-    gotoTable.clear();
-
-    // Validate grammar has productions
-    if (grammar.getProductionCount() == 0) {
-        std::cerr << "ERROR: Grammar has no productions!" << std::endl;
-        return;
-    }
-
-    try {
-        // Create augmented start production: S' -> Program $
-        ParserLR1Item startItem(0, 0, GrammarSymbol("$", TokenType::EOF_TOKEN));
-        std::set<ParserLR1Item> startSet = closure({startItem});
-        states.push_back(startSet);
-
-        for (size_t si = 0; si < states.size(); ++si) {
-            const auto& state = states[si];
-
-            std::set<GrammarSymbol> symbolsAfterDot;
-            for (const auto& it : state) {
-                if (it.productionId >= grammar.getProductionCount()) {
-                    std::cerr << "ERROR: Invalid production ID in state: " << it.productionId << std::endl;
-                    continue;
-                }
-                const auto& prod = grammar.getProduction(it.productionId);
-                if (it.dotPosition < prod.rhs.size()) {
-                    symbolsAfterDot.insert(prod.rhs[it.dotPosition]);
-                }
-            }
-
-            for (const auto& sym : symbolsAfterDot) {
-                std::set<ParserLR1Item> g = gotoState(state, sym);
-                if (g.empty()) continue;
-
-                int nextState = findOrAddState(g);
-
-                if (grammar.isTerminal(sym)) {
-                    auto& entry = actionTable[static_cast<int>(si)][sym];
-
-                    if (entry.type != ActionType::ERROR) {
-                        std::cerr << "WARNING: Shift/Reduce conflict in state " << si
-                                  << " on symbol " << sym.name << std::endl;
-                    }
-
-                    entry = Action(ActionType::SHIFT, nextState);
-                } else {
-                    gotoTable[static_cast<int>(si)][sym] = nextState;
-                }
-            }
-
-            for (const auto& it : state) {
-                if (it.productionId >= grammar.getProductionCount()) {
-                    continue;
-                }
-
-                const auto& prod = grammar.getProduction(it.productionId);
-                
-                if (it.dotPosition == prod.rhs.size()) {
-                    if (it.productionId == 0 && prod.lhs == grammar.getStartSymbol()) {
-                        if (it.lookahead.name == "$") {
-                            actionTable[static_cast<int>(si)][it.lookahead] =
-                                Action(ActionType::ACCEPT, 0);
-                        }
-                    } else {
-                        auto& entry = actionTable[static_cast<int>(si)][it.lookahead];
-
-                        if (entry.type == ActionType::REDUCE) {
-                            std::cerr << "WARNING: Reduce/Reduce conflict in state " << si
-                                      << " on lookahead " << it.lookahead.name << std::endl;
-                        }
-                        else if (entry.type == ActionType::SHIFT) {
-                            std::cerr << "WARNING: Shift/Reduce conflict in state " << si
-                                      << " on lookahead " << it.lookahead.name
-                                      << " (preferring shift)" << std::endl;
-                            continue;
-                        }
-
-                        entry = Action(ActionType::REDUCE, it.productionId);
-                    }
-                }
-            }
-        }
-
-        std::cout << "✓ Generated " << states.size() << " states" << std::endl;
-        std::cout << "✓ ACTION table entries: " << actionTable.size() << std::endl;
-        std::cout << "✓ GOTO table entries: " << gotoTable.size() << std::endl;
-
-    } catch (const std::exception& ex) {
-        std::cerr << "EXCEPTION in buildParsingTable: " << ex.what() << std::endl;
-        throw;
-    }
-
-    std::cout << "=================================\n" << std::endl;
-}
-
-std::set<LR1Parser::ParserLR1Item> LR1Parser::closure(const std::set<ParserLR1Item>& items) {
-    std::set<ParserLR1Item> result = items;
-    bool changed = true;
-    int iterations = 0;
-
-    while (changed && iterations < 100) {
-        changed = false;
-        iterations++;
-        std::set<ParserLR1Item> toAdd;
-
-        for (const auto& item : result) {
-            if (item.productionId >= grammar.getProductionCount()) {
-                continue;
-            }
-
-            const auto& prod = grammar.getProduction(item.productionId);
-
-            if (item.dotPosition >= prod.rhs.size()) {
-                continue;
-            }
-
-            const GrammarSymbol& nextSymbol = prod.rhs[item.dotPosition];
-
-            // std::cout << "[closure] Checking symbol: " << nextSymbol.name 
-            //          << " isNonTerminal? " << grammar.isNonTerminal(nextSymbol) << std::endl;
-
-            if (!grammar.isNonTerminal(nextSymbol)) {
-                continue;
-            }
-
-            const auto& allProds = grammar.getProductions();
-            for (size_t prodIdx = 0; prodIdx < allProds.size(); ++prodIdx) {
-                const auto& newProd = allProds[prodIdx];
-
-                if (newProd.lhs == nextSymbol) {
-                    std::vector<GrammarSymbol> beta;
-                    if (item.dotPosition + 1 < prod.rhs.size()) {
-                        beta.insert(beta.end(),
-                                   prod.rhs.begin() + item.dotPosition + 1,
-                                   prod.rhs.end());
-                    }
-                    beta.push_back(item.lookahead);
-
-                    auto firstSet = grammar.getFirst(beta);
-                    
-                    // std::cout << "   FIRST(" << nextSymbol.name << ") has " 
-                    //           << firstSet.size() << " items" << std::endl;
-
-                    for (const auto& lookahead : firstSet) {
-                        if (lookahead.name == "ε" || lookahead.name == "epsilon") {
-                            continue;
-                        }
-
-                        ParserLR1Item newItem(static_cast<int>(prodIdx), 0, lookahead);
-
-                        if (result.find(newItem) == result.end() && 
-                            toAdd.find(newItem) == toAdd.end()) {
-                            toAdd.insert(newItem);
-                            changed = true;
-                            // std::cout << "     + Added item for production " << prodIdx << std::endl;
-                        }
-                    }
-                }
-            }
-        }
-
-        result.insert(toAdd.begin(), toAdd.end());
-    }
-
-    // std::cout << "[closure] Final result: " << result.size() << " items" << std::endl;
-    return result;
-}
-
-std::set<LR1Parser::ParserLR1Item> LR1Parser::gotoState(const std::set<ParserLR1Item>& items, const GrammarSymbol& symbol) {
-    std::set<ParserLR1Item> moved;
-
-    // std::cout << "    [gotoState] Looking for symbol: '" << symbol.name 
-    //           << "' (type: " << static_cast<int>(symbol.tokenType) << ")" << std::endl;
-
-    for (const auto& item : items) {
-        if (item.productionId >= grammar.getProductionCount()) continue;
-
-        const auto& prod = grammar.getProduction(item.productionId);
-
-        if (item.dotPosition < prod.rhs.size()) {
-            const GrammarSymbol& itemSym = prod.rhs[item.dotPosition];
-            
-            // bool match = (itemSym == symbol);
-            // std::cout << "      Item symbol: '" << itemSym.name 
-            //           << "' (type: " << static_cast<int>(itemSym.tokenType) 
-            //           << ") == '" << symbol.name << "'? " << match << std::endl;
-            
-            if (itemSym == symbol) {
-                moved.insert(ParserLR1Item(item.productionId, item.dotPosition + 1, item.lookahead));
-                // std::cout << "         ✓ MATCH! Moving dot forward." << std::endl;
-            }
-        }
-    }
-    
-    // std::cout << "    [gotoState] Found " << moved.size() << " items to move" << std::endl;
-    return closure(moved);
-}
-
-int LR1Parser::findOrAddState(const std::set<ParserLR1Item>& state) {
-    for (size_t i = 0; i < states.size(); ++i) {
-        if (states[i] == state) return static_cast<int>(i);
-    }
-    states.push_back(state);
-    return static_cast<int>(states.size() - 1);
-}
-
-// LR1Parser.cpp — replace tokenToGrammarSymbol implementation with this:
-GrammarSymbol LR1Parser::tokenToGrammarSymbol(const Token& token) const {
-    switch (token.type) {
-        // Keywords / type keywords
-        case TokenType::VAR:          return GrammarSymbol("VAR", TokenType::VAR);
-        case TokenType::INT:          return GrammarSymbol("INT", TokenType::INT);
-        case TokenType::FLOAT_KW:     return GrammarSymbol("FLOAT", TokenType::FLOAT_KW);
-        case TokenType::STRING_KW:    return GrammarSymbol("STRING", TokenType::STRING_KW);
-        case TokenType::BOOL:         return GrammarSymbol("BOOL", TokenType::BOOL);
-        case TokenType::VOID:         return GrammarSymbol("VOID", TokenType::VOID);
-
-        // Control / function keywords
-        case TokenType::IF:           return GrammarSymbol("IF", TokenType::IF);
-        case TokenType::ELSE:         return GrammarSymbol("ELSE", TokenType::ELSE);
-        case TokenType::WHILE:        return GrammarSymbol("WHILE", TokenType::WHILE);
-        case TokenType::FOR:          return GrammarSymbol("FOR", TokenType::FOR);
-        case TokenType::RETURN:       return GrammarSymbol("RETURN", TokenType::RETURN);
-        case TokenType::FUNCTION:     return GrammarSymbol("FUNCTION", TokenType::FUNCTION);
-        case TokenType::CONST:        return GrammarSymbol("CONST", TokenType::CONST);
-
-        // Boolean literals — make names match grammar (TRUE_LIT / FALSE_LIT)
-        case TokenType::TRUE:         return GrammarSymbol("TRUE_LIT", TokenType::TRUE);
-        case TokenType::FALSE:        return GrammarSymbol("FALSE_LIT", TokenType::FALSE);
-
-        // Identifiers / literals
-        case TokenType::IDENTIFIER:   return GrammarSymbol("IDENTIFIER", TokenType::IDENTIFIER);
-        case TokenType::INTEGER:      return GrammarSymbol("INTEGER", TokenType::INTEGER);
-        case TokenType::FLOAT:        return GrammarSymbol("FLOAT_VAL", TokenType::FLOAT);
-        case TokenType::STRING:       return GrammarSymbol("STRING_VAL", TokenType::STRING);
-        case TokenType::BOOLEAN:      return GrammarSymbol("BOOLEAN", TokenType::BOOLEAN);
-
-        // Operators
-        case TokenType::ASSIGN:       return GrammarSymbol("ASSIGN", TokenType::ASSIGN);
-        case TokenType::PLUS:         return GrammarSymbol("PLUS", TokenType::PLUS);
-        case TokenType::MINUS:        return GrammarSymbol("MINUS", TokenType::MINUS);
-        case TokenType::MULTIPLY:     return GrammarSymbol("MULTIPLY", TokenType::MULTIPLY);
-        case TokenType::DIVIDE:       return GrammarSymbol("DIVIDE", TokenType::DIVIDE);
-        case TokenType::MODULO:       return GrammarSymbol("MODULO", TokenType::MODULO);
-        case TokenType::EQUAL:        return GrammarSymbol("EQUAL", TokenType::EQUAL);
-        case TokenType::NOT_EQUAL:    return GrammarSymbol("NOT_EQUAL", TokenType::NOT_EQUAL);
-        case TokenType::LESS:         return GrammarSymbol("LESS", TokenType::LESS);
-        case TokenType::LESS_EQUAL:   return GrammarSymbol("LESS_EQUAL", TokenType::LESS_EQUAL);
-        case TokenType::GREATER:      return GrammarSymbol("GREATER", TokenType::GREATER);
-        case TokenType::GREATER_EQUAL:return GrammarSymbol("GREATER_EQUAL", TokenType::GREATER_EQUAL);
-        case TokenType::LOGICAL_AND:  return GrammarSymbol("AND", TokenType::LOGICAL_AND);
-        case TokenType::LOGICAL_OR:   return GrammarSymbol("OR", TokenType::LOGICAL_OR);
-        case TokenType::LOGICAL_NOT:  return GrammarSymbol("NOT", TokenType::LOGICAL_NOT);
-
-        // Punctuation
-        case TokenType::SEMICOLON:    return GrammarSymbol("SEMICOLON", TokenType::SEMICOLON);
-        case TokenType::COMMA:        return GrammarSymbol("COMMA", TokenType::COMMA);
-        case TokenType::DOT:          return GrammarSymbol("DOT", TokenType::DOT);
-        case TokenType::LEFT_PAREN:   return GrammarSymbol("LPAREN", TokenType::LEFT_PAREN);
-        case TokenType::RIGHT_PAREN:  return GrammarSymbol("RPAREN", TokenType::RIGHT_PAREN);
-        case TokenType::LEFT_BRACE:   return GrammarSymbol("LBRACE", TokenType::LEFT_BRACE);
-        case TokenType::RIGHT_BRACE:  return GrammarSymbol("RBRACE", TokenType::RIGHT_BRACE);
-        case TokenType::LEFT_BRACKET: return GrammarSymbol("LBRACKET", TokenType::LEFT_BRACKET);
-        case TokenType::RIGHT_BRACKET:return GrammarSymbol("RBRACKET", TokenType::RIGHT_BRACKET);
-
-        // EOF / others
-        case TokenType::EOF_TOKEN:    return GrammarSymbol("$", TokenType::EOF_TOKEN);
-        case TokenType::NEWLINE:      return GrammarSymbol("NEWLINE", TokenType::NEWLINE);
-
-        default:
-            return GrammarSymbol("ERROR", TokenType::ERROR_TOKEN);
-    }
-}
-
-std::shared_ptr<ASTNode> LR1Parser::buildAST(const std::vector<std::shared_ptr<ASTNode>>& children, int productionId) {
-    const auto& production = grammar.getProduction(productionId);
-
-    if (production.lhs.name == "Program") {
-        auto node = std::make_shared<ASTNode>(ASTNodeType::PROGRAM);
-        node->children = children;
-        return node;
-    } else if (production.lhs.name == "VarDecl") {
-        auto node = std::make_shared<ASTNode>(ASTNodeType::VARIABLE_DECLARATION);
-        node->children = children;
-        return node;
-    } else if (production.lhs.name == "Expr" || production.lhs.name == "Term") {
-        if (children.size() == 3) {
-            auto node = std::make_shared<ASTNode>(ASTNodeType::BINARY_OPERATION, children[1]->value);
-            node->children.push_back(children[0]);
-            node->children.push_back(children[2]);
-            return node;
-        }
-        if (!children.empty()) return children[0];
-    } else if (production.lhs.name == "Factor") {
-        if (children.size() == 1) return children[0];
-        if (children.size() == 3) return children[1];
-    }
-
-    if (!children.empty()) return children[0];
-    return std::make_shared<ASTNode>(ASTNodeType::EMPTY);
-}
-
-} // namespace SCERSE
+#include "LR1Parser.hpp"
+#include "../common/ThreadPool.hpp"
+#ifdef SCERSE_HAVE_GENERATED_PARSER
+#include "GeneratedParser.hpp"
+#endif
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <type_traits>
+
+namespace SCERSE {
+
+namespace {
+
+// Stand-in for the EOF token when a span does not end with one
+const Token endOfInput(TokenType::EOF_TOKEN, "$", Position());
+
+inline const Token& tokenAt(const Token* tokens, size_t count, size_t index) {
+    return index < count ? tokens[index] : endOfInput;
+}
+
+// Diagnostic for a token no ACTION entry accepts. An ERROR_TOKEN is a
+// character the Lexer could not start a token with; a lone '"' is one
+// only when no closing quote follows on its line. Control bytes (a NUL
+// in the text, say) are shown as \xNN.
+std::string unexpected(const Token& token) {
+    if (token.type != TokenType::ERROR_TOKEN) return "Unexpected token: " + std::string(token.lexeme);
+    if (token.lexeme == "\"") return "Unterminated string literal";
+    unsigned char c = static_cast<unsigned char>(token.lexeme[0]);
+    if (c < 0x20 || c == 0x7f) {
+        char escaped[8];
+        std::snprintf(escaped, sizeof(escaped), "\\x%02X", c);
+        return std::string("Unexpected character: ") + escaped;
+    }
+    return "Unexpected character: " + std::string(token.lexeme);
+}
+
+// Closing note of a parse cut off at MAX_ERRORS. It is placed at the last
+// error reported rather than at 1:1, which has nothing wrong with it.
+CompilerError tooManyErrors(const ParseResult& result) {
+    Position position = result.errors.empty() ? Position() : result.errors.back().position;
+    return CompilerError(ErrorSeverity::ERROR, "Too many errors - stopping parse", position);
+}
+
+// Token sources for LR1Parser::run(). Stack values refer to shifted
+// tokens by a source-specific index, resolved with token().
+
+// Caller-owned token span; every token stays addressable by position.
+// The read position lives in the ParseState so hooks can move it.
+class SpanSource {
+public:
+    SpanSource(const Token* tokens, size_t count, size_t& position)
+        : tokens(tokens), count(count),
+          length(count > 0 && tokens[count - 1].type == TokenType::EOF_TOKEN ? count : count + 1),
+          idx(position) {}
+
+    bool done() const { return idx >= length; }
+    const Token& current() const { return tokenAt(tokens, count, idx); }
+    void skip() { ++idx; }
+    int32_t shift() { return static_cast<int32_t>(idx++); }
+    void reduce(size_t, ParseValue&) {}
+    const Token& token(int32_t ref) const { return tokenAt(tokens, count, static_cast<size_t>(ref)); }
+    size_t sizeHint() const { return count; }
+
+private:
+    const Token* tokens;
+    size_t count;
+    size_t length;
+    size_t& idx;
+};
+
+struct NoHook {
+    bool beforeAction(ParseState&, ParseResult&) { return true; }
+};
+
+// Sinks for LR1Parser::run(). TreeBuilder keeps semantic values and builds
+// the AST; any other sink only sees tokens and production ids.
+struct TreeBuilder {};
+
+struct NoEvents {
+    void shift(const Token&) {}
+    void reduce(int) {}
+};
+
+// Pulls tokens from a Lexer one at a time. Only shifted tokens that a
+// stack value may still turn into a leaf are kept, so the buffer never
+// outgrows the value stack. Unlike Lexer::tokenize(), an ERROR_TOKEN does
+// not end the input: the parser reports it like any unexpected token
+// (counting toward MAX_ERRORS) and lexing goes on after it.
+class LexerSource {
+public:
+    LexerSource(Lexer& lexer, std::vector<Token>& shifted, std::vector<uint32_t>& marks)
+        : lexer(lexer), shifted(shifted), marks(marks) {
+        shifted.clear();
+        marks.clear();
+        next();
+    }
+
+    bool done() const { return finished; }
+    const Token& current() const { return lookahead; }
+
+    void skip() {
+        if (lookahead.type == TokenType::EOF_TOKEN) {
+            finished = true;
+        } else {
+            next();
+        }
+    }
+
+    int32_t shift() {
+        marks.push_back(static_cast<uint32_t>(shifted.size()));
+        shifted.push_back(lookahead);
+        skip();
+        return static_cast<int32_t>(shifted.size() - 1);
+    }
+
+    // 'popped' values were replaced by 'value'; drop the tokens they held
+    // unless value passes one of them through
+    void reduce(size_t popped, ParseValue& value) {
+        uint32_t base = popped > 0 ? marks[marks.size() - popped] : static_cast<uint32_t>(shifted.size());
+        marks.resize(marks.size() - popped);
+        if (value.token >= 0) {
+            if (static_cast<uint32_t>(value.token) != base) {
+                shifted[base] = std::move(shifted[value.token]);
+            }
+            value.token = static_cast<int32_t>(base);
+            shifted.resize(base + 1);
+        } else {
+            shifted.resize(base);
+        }
+        marks.push_back(base);
+    }
+
+    const Token& token(int32_t ref) const { return shifted[ref]; }
+    size_t sizeHint() const { return 0; }
+
+private:
+    Lexer& lexer;
+    std::vector<Token>& shifted;
+    std::vector<uint32_t>& marks;   // shifted.size() when each stack value was pushed
+    Token lookahead;
+    bool finished = false;
+
+    void next() {
+        lookahead = lexer.getNextToken();
+    }
+};
+
+// State stacks for LR1Parser::recognizeOn()
+
+// The parser's own stack, changed in place
+class OwnedStack {
+public:
+    explicit OwnedStack(std::vector<int>& states) : states(states) {}
+
+    size_t size() const { return states.size(); }
+    int top() const { return states.back(); }
+    void push(int state) { states.push_back(state); }
+    void pop(size_t n) { states.resize(states.size() - n); }
+
+private:
+    std::vector<int>& states;
+};
+
+// A read-only snapshot plus the states pushed on top of it. Popping into
+// the snapshot just moves 'shared' down, so nothing is ever copied.
+class OverlayStack {
+public:
+    OverlayStack(const std::vector<int>& snapshot, std::vector<int>& above)
+        : snapshot(snapshot), shared(snapshot.size()), above(above) {
+        above.clear();
+    }
+
+    size_t size() const { return shared + above.size(); }
+    int top() const { return above.empty() ? snapshot[shared - 1] : above.back(); }
+    void push(int state) { above.push_back(state); }
+
+    void pop(size_t n) {
+        size_t fromAbove = std::min(n, above.size());
+        above.resize(above.size() - fromAbove);
+        shared -= n - fromAbove;
+    }
+
+private:
+    const std::vector<int>& snapshot;
+    size_t shared;   // snapshot entries still on the stack
+    std::vector<int>& above;
+};
+
+} // namespace
+
+LR1Parser::LR1Parser() : table(ParseTable::shared()) {}
+
+LR1Parser::LR1Parser(std::shared_ptr<const ParseTable> parseTable)
+    : table(std::move(parseTable)) {}
+
+ParseResult LR1Parser::parse(const std::vector<Token>& tokens) const {
+    return parse(tokens.data(), tokens.size());
+}
+
+bool LR1Parser::setBackend(ParserBackend requested) {
+    if (requested == ParserBackend::DIRECT) {
+#ifdef SCERSE_HAVE_GENERATED_PARSER
+        // The generated code hard-wires state numbers, so it only fits the
+        // table it was generated from
+        if (!table || table->getData().grammarHash != GeneratedParser::GRAMMAR_HASH ||
+            table->getData().mode != GeneratedParser::MODE ||
+            table->getData().encoding != GeneratedParser::ENCODING ||
+            table->getData().stateCount != GeneratedParser::STATE_COUNT) {
+            std::cerr << "WARNING: Generated parser does not match the parse table - "
+                      << "keeping the table backend" << std::endl;
+            return false;
+        }
+#else
+        std::cerr << "WARNING: Built without a generated parser - keeping the table backend" << std::endl;
+        return false;
+#endif
+    }
+    backend = requested;
+    return true;
+}
+
+LR1Parser::ParseStacks& LR1Parser::threadStacks() {
+    thread_local ParseStacks stacks;
+    return stacks;
+}
+
+ParseResult LR1Parser::parse(const Token* tokens, size_t count) const {
+    TreeBuilder builder;
+    return parseSpan(tokens, count, builder);
+}
+
+ParseResult LR1Parser::parse(Lexer& lexer) const {
+    TreeBuilder builder;
+    return parseStream(lexer, builder);
+}
+
+std::vector<ParseResult> LR1Parser::parseBatch(const std::vector<std::vector<Token>>& tokenStreams,
+                                               ThreadPool& pool) const {
+    std::vector<ParseResult> results(tokenStreams.size());
+    pool.parallelFor(tokenStreams.size(), [&](size_t i) {
+        results[i] = parse(tokenStreams[i]);
+    });
+    return results;
+}
+
+std::vector<ParseResult> LR1Parser::parseBatch(const std::vector<std::string>& sources,
+                                               ThreadPool& pool) const {
+    std::vector<ParseResult> results(sources.size());
+    pool.parallelFor(sources.size(), [&](size_t i) {
+        Lexer lexer(sources[i]);
+        results[i] = parse(lexer);
+    });
+    return results;
+}
+
+ParseResult LR1Parser::parse(const Token* tokens, size_t count, ParseEvents& events) const {
+    return parseSpan(tokens, count, events);
+}
+
+ParseResult LR1Parser::parse(Lexer& lexer, ParseEvents& events) const {
+    return parseStream(lexer, events);
+}
+
+ParseResult LR1Parser::validate(const std::vector<Token>& tokens) const {
+    return validate(tokens.data(), tokens.size());
+}
+
+ParseResult LR1Parser::validate(const Token* tokens, size_t count) const {
+    NoEvents none;
+    return parseSpan(tokens, count, none);
+}
+
+ParseResult LR1Parser::validate(Lexer& lexer) const {
+    NoEvents none;
+    return parseStream(lexer, none);
+}
+
+template <typename Sink>
+ParseResult LR1Parser::parseSpan(const Token* tokens, size_t count, Sink& sink) const {
+    ParseResult result;
+    result.success = true;
+    
+    for (size_t i = 0; i < count; ++i) {
+        const Token& token = tokens[i];
+        if (token.type == TokenType::ERROR_TOKEN) {
+            result.success = false;
+            result.errors.push_back(
+                CompilerError(ErrorSeverity::ERROR,
+                              "Unexpected or unknown token: " + std::string(token.lexeme),
+                              Position(token.position.line, token.position.column))
+            );
+        }
+    }
+    
+    if (count > 0 && tokens[count - 1].type != TokenType::EOF_TOKEN) {
+        result.success = false;
+        result.errors.push_back(
+            CompilerError(ErrorSeverity::ERROR,
+                          "Missing end-of-file token",
+                          Position(tokens[count - 1].position.line, tokens[count - 1].position.column))
+        );
+    }
+    
+    if (!table || table->getStateCount() == 0) {
+        std::cerr << "Warning: Parser states table is empty - skipping syntax analysis\n";
+        return result;
+    }
+    
+    ParseState& state = threadStacks().state;
+    state.states.clear();
+    SpanSource source(tokens, count, state.position);
+    if (backend == ParserBackend::DIRECT) {
+        runDirect(source, state, result, sink);
+    } else {
+        NoHook hook;
+        run(source, state, result, hook, sink);
+    }
+    return result;
+}
+
+template <typename Sink>
+ParseResult LR1Parser::parseStream(Lexer& lexer, Sink& sink) const {
+    ParseResult result;
+    result.success = true;
+    
+    if (!table || table->getStateCount() == 0) {
+        std::cerr << "Warning: Parser states table is empty - skipping syntax analysis\n";
+        return result;
+    }
+    
+    ParseStacks& stacks = threadStacks();
+    stacks.state.states.clear();
+    LexerSource source(lexer, stacks.tokens, stacks.tokenMarks);
+    if (backend == ParserBackend::DIRECT) {
+        runDirect(source, stacks.state, result, sink);
+    } else {
+        NoHook hook;
+        run(source, stacks.state, result, hook, sink);
+    }
+    return result;
+}
+
+void LR1Parser::resume(const Token* tokens, size_t count, ParseState& state,
+                       ParseResult& result, ParseHook* hook) const {
+    if (!table || table->getStateCount() == 0) return;
+    
+    SpanSource source(tokens, count, state.position);
+    TreeBuilder builder;
+    if (hook) {
+        run(source, state, result, *hook, builder);
+    } else {
+        NoHook none;
+        run(source, state, result, none, builder);
+    }
+}
+
+RecognizeStatus LR1Parser::recognize(ParseState& state, const Token* tokens, size_t count) const {
+    if (!table || table->getStateCount() == 0) return RecognizeStatus::ERROR;
+    if (state.states.empty()) {
+        state.states.push_back(0);
+        state.position = 0;
+    }
+    OwnedStack stack(state.states);
+    return recognizeOn(stack, tokens, count, state.position);
+}
+
+RecognizeStatus LR1Parser::probe(const ParseState& state, const Token* tokens, size_t count,
+                                 size_t& consumed) const {
+    consumed = 0;
+    if (!table || table->getStateCount() == 0 || state.states.empty()) return RecognizeStatus::ERROR;
+    OverlayStack stack(state.states, threadStacks().probeStates);
+    return recognizeOn(stack, tokens, count, consumed);
+}
+
+template <typename Stack>
+RecognizeStatus LR1Parser::recognizeOn(Stack& stack, const Token* tokens, size_t count,
+                                       size_t& position) const {
+    while (position < count) {
+        int terminal = table->terminalIndex(tokens[position].type);
+        Action action = terminal >= 0 ? table->getAction(stack.top(), terminal) : Action();
+        
+        switch (action.type) {
+            case ActionType::SHIFT:
+                stack.push(action.value);
+                ++position;
+                break;
+                
+            case ActionType::REDUCE: {
+                const auto& prod = table->getProductionInfo(action.value);
+                size_t rhsLength = static_cast<size_t>(prod.rhsLength);
+                if (rhsLength >= stack.size()) return RecognizeStatus::ERROR;
+                stack.pop(rhsLength);
+                int gotoState = table->getGoto(stack.top(), prod.lhs);
+                if (gotoState < 0) return RecognizeStatus::ERROR;
+                stack.push(gotoState);
+                break;
+            }
+            
+            case ActionType::ACCEPT:
+                return RecognizeStatus::ACCEPTED;
+                
+            case ActionType::ERROR:
+            default:
+                return RecognizeStatus::ERROR;
+        }
+    }
+    return RecognizeStatus::NEED_INPUT;
+}
+
+template <typename Source, typename Hook, typename Sink>
+void LR1Parser::run(Source& source, ParseState& state, ParseResult& result, Hook& hook, Sink& sink) const {
+    // Without the AST there are no semantic values to keep
+    constexpr bool buildTree = std::is_same<Sink, TreeBuilder>::value;
+    
+    std::vector<int>& stateStack = state.states;
+    std::vector<ParseValue>& valueStack = state.values;
+    if (stateStack.empty()) {
+        // Fresh parse; roughly one node per token saves regrowing the arena
+        if (buildTree) result.ast.reserve(source.sizeHint());
+        valueStack.clear();
+        stateStack.push_back(0);
+        state.position = 0;
+        state.errorCount = 0;
+    }
+    
+    int& errorCount = state.errorCount;
+    
+    while (!source.done() && errorCount < MAX_ERRORS) {
+        if (!hook.beforeAction(state, result)) return;
+        
+        if (stateStack.empty()) {
+            result.errors.push_back(
+                CompilerError(ErrorSeverity::ERROR,
+                              "Parser state stack empty - cannot continue",
+                              Position())
+            );
+            break;
+        }
+        
+        int curState = stateStack.back();
+        const Token& curToken = source.current();
+        int terminal = table->terminalIndex(curToken.type);
+        
+        Action action = terminal >= 0 ? table->getAction(curState, terminal) : Action();
+        if (action.type == ActionType::ERROR) {
+            result.success = false;
+            result.errors.push_back(
+                CompilerError(ErrorSeverity::ERROR,
+                              unexpected(curToken),
+                              Position(curToken.position.line, curToken.position.column))
+            );
+            
+            source.skip();
+            ++errorCount;
+            continue;
+        }
+        
+        switch (action.type) {
+            case ActionType::SHIFT: {
+                stateStack.push_back(action.value);
+                if constexpr (buildTree) {
+                    // The token itself is the value; a leaf is only built
+                    // if a reduction keeps it
+                    ParseValue value;
+                    value.token = source.shift();
+                    valueStack.push_back(value);
+                } else {
+                    sink.shift(curToken);
+                    source.skip();
+                }
+                break;
+            }
+            
+            case ActionType::REDUCE: {
+                const auto& prod = table->getProductionInfo(action.value);
+                size_t rhsLength = static_cast<size_t>(prod.rhsLength);
+                if constexpr (buildTree) {
+                    size_t valueCount = std::min(rhsLength, valueStack.size());
+                    
+                    ParseValue* children = valueStack.data() + valueStack.size() - valueCount;
+                    ParseValue value = buildAST(result.ast, children, valueCount, action.value, source);
+                    source.reduce(valueCount, value);
+                    valueStack.resize(valueStack.size() - valueCount);
+                    valueStack.push_back(value);
+                } else {
+                    sink.reduce(action.value);
+                }
+                stateStack.resize(stateStack.size() - std::min(rhsLength, stateStack.size()));
+                
+                if (!stateStack.empty()) {
+                    int topState = stateStack.back();
+                    int gotoState = table->getGoto(topState, prod.lhs);
+                    if (gotoState >= 0) {
+                        stateStack.push_back(gotoState);
+                    } else {
+                        result.success = false;
+                        result.errors.push_back(
+                            CompilerError(ErrorSeverity::ERROR,
+                                          "Parser table missing GOTO entry during reduce",
+                                          Position())
+                        );
+                        source.skip();
+                        ++errorCount;
+                    }
+                }
+                break;
+            }
+            
+            case ActionType::ACCEPT:
+                if constexpr (buildTree) {
+                    if (!valueStack.empty()) result.ast.setRoot(materialize(result.ast, valueStack.back(), source));
+                }
+                result.success = (errorCount == 0);
+                return;
+                
+            case ActionType::ERROR:
+            default:
+                result.success = false;
+                result.errors.push_back(
+                    CompilerError(ErrorSeverity::ERROR,
+                                  "Parse error at token: " + std::string(curToken.lexeme),
+                                  Position(curToken.position.line, curToken.position.column))
+                );
+                source.skip();
+                ++errorCount;
+                break;
+        }
+    }
+    
+    if (errorCount >= MAX_ERRORS) {
+        result.errors.push_back(tooManyErrors(result));
+    }
+}
+
+
+template <typename Source, typename Sink>
+void LR1Parser::runDirect(Source& source, ParseState& state, ParseResult& result, Sink& sink) const {
+#ifdef SCERSE_HAVE_GENERATED_PARSER
+    // The generated code decides the actions; everything they do to the
+    // stacks, the AST and the diagnostics is exactly what run() does
+    struct Driver {
+        const LR1Parser& parser;
+        Source& source;
+        ParseState& state;
+        ParseResult& result;
+        Sink& sink;
+
+        int lookahead() const { return static_cast<int>(source.current().type); }
+
+        void push(int target) { state.states.push_back(target); }
+
+        void shift() {
+            if constexpr (std::is_same<Sink, TreeBuilder>::value) {
+                ParseValue value;
+                value.token = source.shift();
+                state.values.push_back(value);
+            } else {
+                sink.shift(source.current());
+                source.skip();
+            }
+        }
+
+        // State 0 stays at the bottom: no state reduces past it
+        int reduce(int productionId, int rhsLength) {
+            size_t length = static_cast<size_t>(rhsLength);
+            if constexpr (std::is_same<Sink, TreeBuilder>::value) {
+                std::vector<ParseValue>& values = state.values;
+                size_t valueCount = std::min(length, values.size());
+                ParseValue* children = values.data() + values.size() - valueCount;
+                ParseValue value = parser.buildAST(result.ast, children, valueCount, productionId, source);
+                source.reduce(valueCount, value);
+                values.resize(values.size() - valueCount);
+                values.push_back(value);
+            } else {
+                sink.reduce(productionId);
+            }
+            state.states.resize(state.states.size() - length);
+            return state.states.back();
+        }
+
+        bool error() {
+            const Token& token = source.current();
+            return fail(unexpected(token), Position(token.position.line, token.position.column));
+        }
+
+        bool gotoError() {
+            return fail("Parser table missing GOTO entry during reduce", Position());
+        }
+
+        void accept() {
+            if constexpr (std::is_same<Sink, TreeBuilder>::value) {
+                if (!state.values.empty()) {
+                    result.ast.setRoot(materialize(result.ast, state.values.back(), source));
+                }
+            }
+            result.success = (state.errorCount == 0);
+        }
+
+        // Skip the token; true while the parse goes on
+        bool fail(const std::string& message, const Position& position) {
+            result.success = false;
+            result.errors.push_back(CompilerError(ErrorSeverity::ERROR, message, position));
+            source.skip();
+            ++state.errorCount;
+            return !source.done() && state.errorCount < MAX_ERRORS;
+        }
+    };
+
+    if (std::is_same<Sink, TreeBuilder>::value) result.ast.reserve(source.sizeHint());
+    state.values.clear();
+    state.states.assign(1, 0);
+    state.position = 0;
+    state.errorCount = 0;
+
+    Driver driver{*this, source, state, result, sink};
+    GeneratedParser::run(driver);
+
+    if (state.errorCount >= MAX_ERRORS) {
+        result.errors.push_back(tooManyErrors(result));
+    }
+#else
+    NoHook hook;
+    run(source, state, result, hook, sink);
+#endif
+}
+
+
+template <typename Source>
+NodeId LR1Parser::materialize(ASTArena& ast, ParseValue& value, const Source& source) {
+    if (value.node != NO_NODE) return value.node;
+    if (value.token < 0) {
+        value.node = ast.add(ASTNodeType::EMPTY);
+        return value.node;
+    }
+    const Token& token = source.token(value.token);
+    value.node = ast.add(token.type == TokenType::IDENTIFIER ? ASTNodeType::IDENTIFIER : ASTNodeType::LITERAL,
+                         token.lexeme, SourcePosition(token.position.line, token.position.column));
+    return value.node;
+}
+
+template <typename Source>
+ParseValue LR1Parser::buildAST(ASTArena& ast, ParseValue* children, size_t childCount, int productionId,
+                               const Source& source) const {
+    const SemanticAction& action = table->getGrammar().getProduction(productionId).action;
+    const size_t child = static_cast<size_t>(action.child);
+
+    switch (action.kind) {
+        case SemanticAction::Kind::NODE: {
+            std::string_view text;
+            if (action.text >= 0 && static_cast<size_t>(action.text) < childCount) {
+                const ParseValue& value = children[action.text];
+                if (value.node != NO_NODE) {
+                    text = ast[value.node].value;
+                } else if (value.token >= 0) {
+                    text = source.token(value.token).lexeme;
+                }
+            }
+            ParseValue result;
+            result.node = ast.add(action.type, text);
+            for (size_t i = 0; i < childCount; ++i) {
+                if (action.keep & (uint32_t(1) << i)) {
+                    ast.appendChild(result.node, materialize(ast, children[i], source));
+                }
+            }
+            // A node starts where its first kept child does
+            NodeId first = ast[result.node].firstChild;
+            if (first != NO_NODE) ast[result.node].position = ast[first].position;
+            return result;
+        }
+
+        case SemanticAction::Kind::LEAF:
+            if (child < childCount && children[child].token >= 0) {
+                const Token& token = source.token(children[child].token);
+                ParseValue result;
+                result.node = ast.add(action.type, token.lexeme,
+                                      SourcePosition(token.position.line, token.position.column));
+                return result;
+            }
+            break;
+
+        case SemanticAction::Kind::PREPEND: {
+            const size_t item = static_cast<size_t>(action.item);
+            if (child < childCount && item < childCount) {
+                NodeId list = materialize(ast, children[child], source);
+                NodeId first = materialize(ast, children[item], source);
+                ast.prependChild(list, first);
+                ast[list].position = ast[first].position;
+                return children[child];
+            }
+            break;
+        }
+
+        case SemanticAction::Kind::PASS:
+        default:
+            break;
+    }
+
+    if (child < childCount) return children[child];
+    return ParseValue();
+}
+
+} // namespace SCERSE
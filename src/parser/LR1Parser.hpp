@@ -1,92 +1,269 @@
-#pragma once
-
-
-#include <vector>
-#include <map>
-#include <set>
-#include <stack>
-#include <memory>
-
-
-#include "../lexer/Token.hpp"
-#include "../common/AST.hpp"
-#include "../common/Error.hpp"
-#include "Grammar.hpp"
-
-
-namespace SCERSE {
-
-
-struct ParseResult {
-    std::shared_ptr<ASTNode> ast;
-    std::vector<CompilerError> errors;
-    bool success = true;
-};
-
-
-class LR1Parser {
-public:
-    LR1Parser();
-    ParseResult parse(const std::vector<Token>& tokens);
-
-
-    struct ParserLR1Item {
-    int productionId;
-    int dotPosition;
-    GrammarSymbol lookahead;
-    
-    // ADD THIS CONSTRUCTOR
-    ParserLR1Item() = default;
-    
-    ParserLR1Item(int prodId, int dotPos, const GrammarSymbol& la)
-        : productionId(prodId), dotPosition(dotPos), lookahead(la) {}
-    
-    // CRITICAL: Proper comparison for std::set - COMPARE BY NAME ONLY
-    bool operator<(const ParserLR1Item& other) const {
-        if (productionId != other.productionId) 
-            return productionId < other.productionId;
-        if (dotPosition != other.dotPosition) 
-            return dotPosition < other.dotPosition;
-        // Compare lookahead by name ONLY (not by tokenType)
-        return lookahead.name < other.lookahead.name;
-    }
-    
-    bool operator==(const ParserLR1Item& other) const {
-        return productionId == other.productionId && 
-               dotPosition == other.dotPosition && 
-               lookahead.name == other.lookahead.name;  // Compare by name only
-    }
-};
-
-
-
-
-private:
-
-
-    Grammar grammar;
-
-
-    std::map<int, std::map<GrammarSymbol, Action>> actionTable;
-    std::map<int, std::map<GrammarSymbol, int>> gotoTable;
-
-
-    std::vector<std::set<ParserLR1Item>> states;
-
-
-    void buildParsingTable();
-
-
-    std::set<ParserLR1Item> closure(const std::set<ParserLR1Item>& items);
-    std::set<ParserLR1Item> gotoState(const std::set<ParserLR1Item>& items, const GrammarSymbol& symbol);
-
-
-    int findOrAddState(const std::set<ParserLR1Item>& state);
-
-
-    GrammarSymbol tokenToGrammarSymbol(const Token& token) const;
-    std::shared_ptr<ASTNode> buildAST(const std::vector<std::shared_ptr<ASTNode>>& children, int productionId);
-};
-
-
-} // namespace SCERSE
+#pragma once
+
+
+#include <vector>
+#include <memory>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+
+#include "../lexer/Token.hpp"
+#include "../lexer/Lexer.hpp"
+#include "../common/AST.hpp"
+#include "../common/Error.hpp"
+#include "Grammar.hpp"
+#include "ParseTable.hpp"
+
+
+namespace SCERSE {
+
+class ThreadPool;
+
+
+struct ParseResult {
+    ASTArena ast;                 // empty (false) when nothing was accepted
+    std::vector<CompilerError> errors;
+    bool success = true;
+};
+
+
+/**
+ * ParseValue
+ * Semantic value on the parse stack: a shifted token, referenced by its
+ * index so shifting never allocates, or an AST node built by a reduction.
+ * Neither set means an empty (ε) value.
+ */
+struct ParseValue {
+    NodeId node = NO_NODE;
+    int32_t token = -1;
+};
+
+
+/**
+ * ParseState
+ * LR configuration between two actions: the state and value stacks, the
+ * index of the next input token and the number of errors so far. A copy
+ * is a snapshot a span parse can be resumed from.
+ */
+struct ParseState {
+    std::vector<int> states;
+    std::vector<ParseValue> values;
+    size_t position = 0;
+    int errorCount = 0;
+};
+
+
+/**
+ * ParseHook
+ * Observer for LR1Parser::resume(), called before every action
+ */
+class ParseHook {
+public:
+    virtual ~ParseHook() = default;
+
+    /**
+     * The parser is about to act on tokens[state.position]. The hook may
+     * rewrite state and result (for example to splice in an earlier
+     * parse); returning false stops the parse.
+     */
+    virtual bool beforeAction(ParseState& state, ParseResult& result) = 0;
+};
+
+
+/**
+ * ParseEvents
+ * Receiver for an event-stream parse: told about every shift and every
+ * reduction, in order, instead of getting an AST
+ */
+class ParseEvents {
+public:
+    virtual ~ParseEvents() = default;
+
+    virtual void shift(const Token& token) = 0;
+
+    /**
+     * ParseTable::getProductionInfo(productionId) gives the nonterminal
+     * and how many stack entries it replaced
+     */
+    virtual void reduce(int productionId) = 0;
+};
+
+
+/**
+ * RecognizeStatus
+ * Where LR1Parser::recognize() / probe() stopped
+ */
+enum class RecognizeStatus {
+    ACCEPTED,     // the input was accepted
+    ERROR,        // the next token has no action in the current state
+    NEED_INPUT    // every given token was shifted
+};
+
+
+/**
+ * ParserBackend
+ * How LR1Parser runs the automaton. Both take the same actions, so the
+ * ParseResult is identical; DIRECT needs the code scerse_tablegen
+ * --parser generates for this table (see LR1Parser::setBackend()).
+ */
+enum class ParserBackend {
+    TABLE,    // ACTION/GOTO lookups in ParseTable
+    DIRECT    // generated code with one label per state
+};
+
+
+class LR1Parser {
+public:
+    /**
+     * Parser over the process-wide ParseTable::shared() tables
+     */
+    LR1Parser();
+
+    /**
+     * Parser over a specific (already built) table
+     */
+    explicit LR1Parser(std::shared_ptr<const ParseTable> parseTable);
+
+    /**
+     * Parse a token stream. Const: the parser holds no per-parse state,
+     * so one instance may be used from several threads at once.
+     */
+    ParseResult parse(const std::vector<Token>& tokens) const;
+
+    /**
+     * Parse tokens[0, count) in place; an EOF token is implied if the
+     * span does not end with one. The state and value stacks are
+     * per-thread buffers reused from call to call, so in steady state a
+     * parse only allocates the AST arena it returns (and diagnostics).
+     */
+    ParseResult parse(const Token* tokens, size_t count) const;
+
+    /**
+     * Streaming parse: pulls tokens from lexer.getNextToken() as needed
+     * instead of taking a token vector. Same result as
+     * parse(lexer.tokenize()), but the only tokens held are the lookahead
+     * and those still on the parse stack, so memory follows stack depth
+     * rather than input size. Where tokenize() stops at the first
+     * ERROR_TOKEN, this reports it ("Unexpected character") and goes on.
+     */
+    ParseResult parse(Lexer& lexer) const;
+
+    /**
+     * Parse many inputs concurrently on 'pool'. Every parse shares this
+     * parser's immutable table and runs on its worker's own stacks into
+     * its own arena; results[i] belongs to input i whatever order the
+     * workers finish in. Sources are streamed from a Lexer by the worker
+     * that parses them: same result as parse(Lexer&) on each, so unknown
+     * characters are reported and skipped rather than ending the input as
+     * they do in tokenize().
+     */
+    std::vector<ParseResult> parseBatch(const std::vector<std::vector<Token>>& tokenStreams,
+                                        ThreadPool& pool) const;
+    std::vector<ParseResult> parseBatch(const std::vector<std::string>& sources,
+                                        ThreadPool& pool) const;
+
+    /**
+     * Event-stream parses: same diagnostics as parse(), but shifts and
+     * reductions are reported to 'events' and no AST is built
+     * (result.ast stays empty)
+     */
+    ParseResult parse(const Token* tokens, size_t count, ParseEvents& events) const;
+    ParseResult parse(Lexer& lexer, ParseEvents& events) const;
+
+    /**
+     * Diagnostics only: no AST, no events and no value stack, so the cost
+     * is the table lookups. Errors match parse() exactly.
+     */
+    ParseResult validate(const std::vector<Token>& tokens) const;
+    ParseResult validate(const Token* tokens, size_t count) const;
+    ParseResult validate(Lexer& lexer) const;
+
+    /**
+     * Continue a span parse from 'state', adding to 'result'. An empty
+     * state starts from the beginning. Unlike parse(), the tokens are not
+     * checked for ERROR_TOKEN or a final EOF first. hook may be null.
+     */
+    void resume(const Token* tokens, size_t count, ParseState& state,
+                ParseResult& result, ParseHook* hook) const;
+
+    /**
+     * Run the automaton alone over tokens[state.position, count): no AST,
+     * no diagnostics, no recovery, and state.values is left alone. On
+     * ERROR, 'state' is the configuration the error was found in and
+     * tokens[state.position] the offending token, so the caller can keep
+     * it as a snapshot, try repairs with probe() and then skip the token
+     * and continue as parse() does.
+     */
+    RecognizeStatus recognize(ParseState& state, const Token* tokens, size_t count) const;
+
+    /**
+     * recognize() tokens[0, count) as if they followed the snapshot 'state',
+     * without changing or copying it: only states pushed above the part of
+     * the stack still shared with the snapshot are stored. 'consumed' gets
+     * the number of tokens shifted.
+     */
+    RecognizeStatus probe(const ParseState& state, const Token* tokens, size_t count,
+                          size_t& consumed) const;
+
+    /**
+     * Backend for parse(), validate() and the event-stream parses (resume(),
+     * recognize() and probe() always use the tables). Returns false and
+     * keeps the current backend if this binary has no generated parser
+     * for this parser's table.
+     */
+    bool setBackend(ParserBackend requested);
+    ParserBackend getBackend() const { return backend; }
+
+    // A parse stops after this many errors
+    static constexpr int MAX_ERRORS = 50;
+
+    const ParseTable& getTable() const { return *table; }
+
+private:
+
+    std::shared_ptr<const ParseTable> table;
+    ParserBackend backend = ParserBackend::TABLE;
+
+    // Contiguous parse stacks, kept per thread so capacity survives calls
+    struct ParseStacks {
+        ParseState state;
+        std::vector<Token> tokens;         // streaming mode: shifted tokens still referenced
+        std::vector<uint32_t> tokenMarks;  // streaming mode: tokens.size() per stack value
+        std::vector<int> probeStates;      // probe(): states above the snapshot
+    };
+    static ParseStacks& threadStacks();
+
+    // Entry points over a token span / a Lexer for any sink (see run())
+    template <typename Sink>
+    ParseResult parseSpan(const Token* tokens, size_t count, Sink& sink) const;
+    template <typename Sink>
+    ParseResult parseStream(Lexer& lexer, Sink& sink) const;
+
+    // The LR driver, shared by every entry point. Sink decides what a parse
+    // produces: the AST, ParseEvents callbacks or nothing.
+    template <typename Source, typename Hook, typename Sink>
+    void run(Source& source, ParseState& state, ParseResult& result, Hook& hook, Sink& sink) const;
+
+    // run() with the automaton compiled in (GeneratedParser.hpp) instead
+    // of looked up; no hook, as it is only used for whole parses
+    template <typename Source, typename Sink>
+    void runDirect(Source& source, ParseState& state, ParseResult& result, Sink& sink) const;
+
+    // States-only driver behind recognize() and probe()
+    template <typename Stack>
+    RecognizeStatus recognizeOn(Stack& stack, const Token* tokens, size_t count, size_t& position) const;
+
+    // Turn a stack value into a node (tokens become LITERAL leaves)
+    template <typename Source>
+    static NodeId materialize(ASTArena& ast, ParseValue& value, const Source& source);
+
+    // Semantic value of a reduction: applies the production's
+    // SemanticAction to 'children', the top RHS values
+    template <typename Source>
+    ParseValue buildAST(ASTArena& ast, ParseValue* children, size_t childCount, int productionId,
+                        const Source& source) const;
+};
+
+
+} // namespace SCERSE
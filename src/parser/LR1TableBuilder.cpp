@@ -0,0 +1,442 @@
+#include "LR1TableBuilder.hpp"
+#include "../common/ThreadPool.hpp"
+#include <algorithm>
+#include <iostream>
+#include <map>
+
+namespace SCERSE {
+
+size_t TableBuildReport::countConflicts(bool reduceReduce) const {
+    size_t count = 0;
+    for (const auto& conflict : conflicts) {
+        if (conflict.reduceReduce == reduceReduce) ++count;
+    }
+    return count;
+}
+
+LR1TableBuilder::LR1TableBuilder(const Grammar& g, TableMode m, unsigned threads)
+    : grammar(g), mode(m), threadCount(threads) {
+    computeClosureTemplates();
+}
+
+size_t LR1TableBuilder::build(ActionRows& actionTable, GotoRows& gotoTable) {
+    kernels.clear();
+    states.clear();
+    transitions.clear();
+    merged.clear();
+    queued.clear();
+    worklist.clear();
+    stateIndex.clear();
+    actionTable.clear();
+    gotoTable.clear();
+    report = TableBuildReport();
+    report.mode = mode;
+
+    // Validate grammar has productions
+    if (grammar.getProductionCount() == 0) {
+        std::cerr << "ERROR: Grammar has no productions!" << std::endl;
+        return 0;
+    }
+
+    const size_t terminalCount = grammar.getTerminalCount();
+    const size_t nonTerminalCount = grammar.getNonTerminalCount();
+
+    try {
+        // Create augmented start production: S' -> Program $
+        std::set<LR1Item> startKernel{LR1Item(0, 0, grammar.getEndSymbol().id)};
+        findOrAddState(startKernel, hashItems(startKernel, mode == TableMode::CANONICAL_LR1));
+
+        // Rounds over the worklist: every state queued when a round starts
+        // is expanded in parallel, then the results are committed one by one
+        // in worklist order. Only the commit touches shared state, and the
+        // round boundaries do not depend on the pool size, so the tables
+        // come out bit-identical for any thread count. A state whose kernel
+        // grows through a merge is queued again so its lookaheads reach its
+        // successors.
+        ThreadPool pool(threadCount);
+        std::vector<Expansion> expansions;
+        for (size_t next = 0; next < worklist.size();) {
+            std::vector<int> round(worklist.begin() + next, worklist.end());
+            next = worklist.size();
+            for (int state : round) queued[state] = false;
+
+            expansions.assign(round.size(), Expansion());
+            pool.parallelFor(round.size(), [&](size_t i) {
+                expansions[i] = expand(kernels[round[i]]);
+            });
+
+            for (size_t i = 0; i < round.size(); ++i) {
+                commit(round[i], expansions[i]);
+            }
+        }
+
+        std::vector<int> order = reachableOrder();
+        std::vector<int> number(kernels.size(), -1);
+        for (size_t i = 0; i < order.size(); ++i) {
+            number[order[i]] = static_cast<int>(i);
+        }
+
+        actionTable.assign(order.size(), std::vector<Action>(terminalCount));
+        gotoTable.assign(order.size(), std::vector<int>(nonTerminalCount, -1));
+
+        for (size_t si = 0; si < order.size(); ++si) {
+            const int source = order[si];
+            if (merged[source]) report.mergedStates++;
+
+            for (const auto& edge : transitions[source]) {
+                if (edge.first.isTerminal()) {
+                    actionTable[si][edge.first.id] = Action(ActionType::SHIFT, number[edge.second]);
+                } else {
+                    gotoTable[si][edge.first.id] = number[edge.second];
+                }
+            }
+
+            const char* where = merged[source] ? " (merged state)" : "";
+
+            for (const auto& it : states[source]) {
+                if (static_cast<size_t>(it.productionId) >= grammar.getProductionCount()) {
+                    continue;
+                }
+
+                const auto& prod = grammar.getProduction(it.productionId);
+
+                if (static_cast<size_t>(it.dotPosition) == prod.rhs.size()) {
+                    if (it.productionId == 0 && prod.lhs == grammar.getStartSymbol()) {
+                        if (it.lookahead == grammar.getEndSymbol().id) {
+                            actionTable[si][it.lookahead] = Action(ActionType::ACCEPT, 0);
+                        }
+                    } else {
+                        auto& entry = actionTable[si][it.lookahead];
+
+                        if (entry.type == ActionType::REDUCE) {
+                            std::cerr << "WARNING: Reduce/Reduce conflict in state " << si
+                                      << " on lookahead " << grammar.getTerminalName(it.lookahead)
+                                      << where << std::endl;
+                            report.conflicts.push_back({static_cast<int>(si), it.lookahead, true, merged[source]});
+                        }
+                        else if (entry.type == ActionType::SHIFT) {
+                            std::cerr << "WARNING: Shift/Reduce conflict in state " << si
+                                      << " on lookahead " << grammar.getTerminalName(it.lookahead)
+                                      << " (preferring shift)" << where << std::endl;
+                            report.conflicts.push_back({static_cast<int>(si), it.lookahead, false, merged[source]});
+                            continue;
+                        }
+
+                        entry = Action(ActionType::REDUCE, it.productionId);
+                    }
+                }
+            }
+        }
+
+        report.stateCount = order.size();
+        std::cout << "✓ Generated " << report.stateCount << " " << to_cstring(mode) << " states";
+        if (mode != TableMode::CANONICAL_LR1) {
+            std::cout << " (" << report.mergedStates << " merged)";
+        }
+        std::cout << std::endl;
+
+    } catch (const std::exception& ex) {
+        std::cerr << "EXCEPTION in buildParsingTable: " << ex.what() << std::endl;
+        throw;
+    }
+
+    // Item sets are only needed during construction
+    kernels.clear();
+    states.clear();
+    transitions.clear();
+    merged.clear();
+    queued.clear();
+    worklist.clear();
+    stateIndex.clear();
+    return report.stateCount;
+}
+
+LR1TableBuilder::Expansion LR1TableBuilder::expand(const std::set<LR1Item>& kernel) const {
+    Expansion result;
+    result.items = closure(kernel);
+
+    // GOTO kernels for every symbol after a dot, in one pass over the items
+    std::map<GrammarSymbol, std::set<LR1Item>> moved;
+    for (const auto& it : result.items) {
+        if (static_cast<size_t>(it.productionId) >= grammar.getProductionCount()) {
+            continue;
+        }
+        const auto& prod = grammar.getProduction(it.productionId);
+        if (static_cast<size_t>(it.dotPosition) < prod.rhs.size()) {
+            moved[prod.rhs[it.dotPosition]].insert(LR1Item(it.productionId, it.dotPosition + 1, it.lookahead));
+        }
+    }
+
+    const bool canonical = mode == TableMode::CANONICAL_LR1;
+    for (auto& entry : moved) {
+        result.hashes.push_back(hashItems(entry.second, canonical));
+        result.symbols.push_back(entry.first);
+        result.successors.push_back(std::move(entry.second));
+    }
+    return result;
+}
+
+void LR1TableBuilder::commit(int state, Expansion& expansion) {
+    states[state] = std::move(expansion.items);
+
+    std::vector<std::pair<GrammarSymbol, int>> edges;
+    for (size_t k = 0; k < expansion.symbols.size(); ++k) {
+        edges.emplace_back(expansion.symbols[k], findOrAddState(expansion.successors[k], expansion.hashes[k]));
+    }
+    transitions[state] = std::move(edges);
+}
+
+void LR1TableBuilder::computeClosureTemplates() {
+    const size_t nonTerminalCount = grammar.getNonTerminalCount();
+    closureTemplates.assign(nonTerminalCount, std::vector<ClosureEntry>());
+
+    std::vector<TerminalSet> spontaneous(nonTerminalCount);
+    std::vector<bool> propagates(nonTerminalCount);
+    std::vector<bool> reached(nonTerminalCount);
+
+    for (size_t root = 0; root < nonTerminalCount; ++root) {
+        std::fill(spontaneous.begin(), spontaneous.end(), TerminalSet());
+        std::fill(propagates.begin(), propagates.end(), false);
+        std::fill(reached.begin(), reached.end(), false);
+
+        // Expanding 'root' with lookaheads L gives B -> ·δ items with
+        // lookaheads spontaneous[B] ∪ (propagates[B] ? L : ∅)
+        std::vector<int> order{static_cast<int>(root)};
+        reached[root] = true;
+        propagates[root] = true;
+
+        // Every update only adds bits, so this reaches a fixed point after
+        // at most (terminals + 1) * nonterminals changes
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (size_t k = 0; k < order.size(); ++k) {
+                const int B = order[k];
+                for (int prodIdx : grammar.getProductionsFor(B)) {
+                    const auto& rhs = grammar.getProduction(prodIdx).rhs;
+                    if (rhs.empty() || !grammar.isNonTerminal(rhs[0])) continue;
+
+                    // B -> C β: C sees FIRST(β), and B's lookaheads if β ⇒* ε
+                    const int C = rhs[0].id;
+                    TerminalSet lookaheads;
+                    bool betaNullable = grammar.firstOfSequence(rhs.data() + 1, rhs.data() + rhs.size(), lookaheads);
+                    if (betaNullable) lookaheads.merge(spontaneous[B]);
+
+                    if (!reached[C]) {
+                        reached[C] = true;
+                        order.push_back(C);
+                        changed = true;
+                    }
+                    TerminalSet before = spontaneous[C];
+                    spontaneous[C].merge(lookaheads);
+                    if (spontaneous[C] != before) changed = true;
+                    if (betaNullable && propagates[B] && !propagates[C]) {
+                        propagates[C] = true;
+                        changed = true;
+                    }
+                }
+            }
+        }
+
+        for (int B : order) {
+            closureTemplates[root].push_back({B, spontaneous[B], propagates[B]});
+        }
+    }
+}
+
+std::set<LR1Item> LR1TableBuilder::closure(const std::set<LR1Item>& items) const {
+    // Lookaheads gathered per nonterminal, then expanded to B -> ·δ items
+    std::vector<TerminalSet> lookaheads(grammar.getNonTerminalCount());
+    std::vector<int> expanded;
+
+    for (const auto& item : items) {
+        if (static_cast<size_t>(item.productionId) >= grammar.getProductionCount()) {
+            continue;
+        }
+
+        const auto& prod = grammar.getProduction(item.productionId);
+
+        if (static_cast<size_t>(item.dotPosition) >= prod.rhs.size()) {
+            continue;
+        }
+
+        const GrammarSymbol& nextSymbol = prod.rhs[item.dotPosition];
+
+        if (!grammar.isNonTerminal(nextSymbol)) {
+            continue;
+        }
+
+        // FIRST(β a), where β is what follows the nonterminal; built in a
+        // stack bitset, so this loop never allocates
+        const GrammarSymbol* beta = prod.rhs.data() + item.dotPosition + 1;
+        TerminalSet firstSet;
+        if (grammar.firstOfSequence(beta, prod.rhs.data() + prod.rhs.size(), firstSet)) {
+            firstSet.set(item.lookahead);
+        }
+
+        for (const auto& entry : closureTemplates[nextSymbol.id]) {
+            TerminalSet entryLookaheads = entry.spontaneous;
+            if (entry.propagates) entryLookaheads.merge(firstSet);
+            if (!entryLookaheads.any()) continue;
+
+            if (!lookaheads[entry.nonTerminal].any()) expanded.push_back(entry.nonTerminal);
+            lookaheads[entry.nonTerminal].merge(entryLookaheads);
+        }
+    }
+
+    std::vector<LR1Item> result(items.begin(), items.end());
+    for (int nonTerminal : expanded) {
+        for (int prodIdx : grammar.getProductionsFor(nonTerminal)) {
+            lookaheads[nonTerminal].forEach([&](int lookahead) {
+                result.emplace_back(prodIdx, 0, lookahead);
+            });
+        }
+    }
+
+    // Sorted input makes the set construction linear
+    std::sort(result.begin(), result.end());
+    return std::set<LR1Item>(result.begin(), result.end());
+}
+
+uint64_t LR1TableBuilder::hashItems(const std::set<LR1Item>& items, bool withLookaheads) {
+    // splitmix64 finalizer over each packed item, folded in set order.
+    // Without lookaheads each LR(0) core item is folded in once.
+    uint64_t hash = 0x9E3779B97F4A7C15ULL;
+    const LR1Item* previous = nullptr;
+    for (const auto& item : items) {
+        if (!withLookaheads && previous && previous->productionId == item.productionId &&
+            previous->dotPosition == item.dotPosition) {
+            continue;
+        }
+        previous = &item;
+
+        uint64_t x = (static_cast<uint64_t>(static_cast<uint32_t>(item.productionId)) << 32) ^
+                     (static_cast<uint64_t>(static_cast<uint16_t>(item.dotPosition)) << 16) ^
+                     (withLookaheads ? static_cast<uint16_t>(item.lookahead) : 0xFFFFu);
+        x += hash + 0x9E3779B97F4A7C15ULL;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        hash = x ^ (x >> 31);
+    }
+    return hash;
+}
+
+namespace {
+
+// Kernel lookaheads grouped by LR(0) item, in item order
+std::vector<std::vector<int>> lookaheadGroups(const std::set<LR1Item>& items) {
+    std::vector<std::vector<int>> groups;
+    const LR1Item* previous = nullptr;
+    for (const auto& item : items) {
+        if (!previous || previous->productionId != item.productionId ||
+            previous->dotPosition != item.dotPosition) {
+            groups.emplace_back();
+        }
+        groups.back().push_back(item.lookahead);
+        previous = &item;
+    }
+    return groups;
+}
+
+bool sameCore(const std::set<LR1Item>& a, const std::set<LR1Item>& b) {
+    auto ia = a.begin();
+    auto ib = b.begin();
+    while (ia != a.end() && ib != b.end()) {
+        if (ia->productionId != ib->productionId || ia->dotPosition != ib->dotPosition) {
+            return false;
+        }
+        const int production = ia->productionId;
+        const int dot = ia->dotPosition;
+        while (ia != a.end() && ia->productionId == production && ia->dotPosition == dot) ++ia;
+        while (ib != b.end() && ib->productionId == production && ib->dotPosition == dot) ++ib;
+    }
+    return ia == a.end() && ib == b.end();
+}
+
+// Both vectors are sorted (they come out of a std::set)
+bool intersects(const std::vector<int>& a, const std::vector<int>& b) {
+    auto ia = a.begin();
+    auto ib = b.begin();
+    while (ia != a.end() && ib != b.end()) {
+        if (*ia == *ib) return true;
+        if (*ia < *ib) ++ia; else ++ib;
+    }
+    return false;
+}
+
+} // namespace
+
+bool LR1TableBuilder::weaklyCompatible(const std::set<LR1Item>& a, const std::set<LR1Item>& b) const {
+    // Pager: merging is safe unless some pair of items would newly share a
+    // lookahead across the two states without already sharing one within
+    // either of them
+    std::vector<std::vector<int>> la = lookaheadGroups(a);
+    std::vector<std::vector<int>> lb = lookaheadGroups(b);
+    for (size_t i = 0; i < la.size(); ++i) {
+        for (size_t j = i + 1; j < la.size(); ++j) {
+            if ((intersects(la[i], lb[j]) || intersects(la[j], lb[i])) &&
+                !intersects(la[i], la[j]) && !intersects(lb[i], lb[j])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int LR1TableBuilder::findOrAddState(const std::set<LR1Item>& kernel, uint64_t hash) {
+    // Average O(1): only kernels with an equal hash are compared item by item
+    const bool canonical = mode == TableMode::CANONICAL_LR1;
+    auto& candidates = stateIndex[hash];
+    for (int id : candidates) {
+        if (canonical) {
+            if (kernels[id] == kernel) return id;
+        } else if (sameCore(kernels[id], kernel) &&
+                   (mode == TableMode::LALR1 || weaklyCompatible(kernels[id], kernel))) {
+            mergeInto(id, kernel);
+            return id;
+        }
+    }
+
+    const int id = static_cast<int>(kernels.size());
+    candidates.push_back(id);
+    kernels.push_back(kernel);
+    states.emplace_back();
+    transitions.emplace_back();
+    merged.push_back(false);
+    queued.push_back(true);
+    worklist.push_back(id);
+    return id;
+}
+
+void LR1TableBuilder::mergeInto(int state, const std::set<LR1Item>& kernel) {
+    std::set<LR1Item>& target = kernels[state];
+    if (target == kernel) return;
+
+    merged[state] = true;
+    const size_t before = target.size();
+    target.insert(kernel.begin(), kernel.end());
+    if (target.size() != before && !queued[state]) {
+        queued[state] = true;
+        worklist.push_back(state);
+    }
+}
+
+std::vector<int> LR1TableBuilder::reachableOrder() const {
+    std::vector<int> order;
+    if (kernels.empty()) return order;
+
+    std::vector<bool> seen(kernels.size(), false);
+    order.push_back(0);
+    seen[0] = true;
+    for (size_t next = 0; next < order.size(); ++next) {
+        for (const auto& edge : transitions[order[next]]) {
+            if (!seen[edge.second]) {
+                seen[edge.second] = true;
+                order.push_back(edge.second);
+            }
+        }
+    }
+    return order;
+}
+
+} // namespace SCERSE
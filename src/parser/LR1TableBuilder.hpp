@@ -0,0 +1,126 @@
+#pragma once
+
+#include <vector>
+#include <set>
+#include <utility>
+#include <unordered_map>
+#include <cstdint>
+
+#include "Grammar.hpp"
+
+namespace SCERSE {
+
+/**
+ * TableConflict
+ * An ACTION cell claimed by more than one item. Shift/reduce conflicts are
+ * resolved in favour of the shift, reduce/reduce in favour of the later item.
+ */
+struct TableConflict {
+    int state;
+    int terminal;
+    bool reduceReduce;   // otherwise shift/reduce
+    bool mergedState;    // state was merged from distinct canonical LR(1) kernels
+};
+
+/**
+ * TableBuildReport
+ * Summary of one construction, for comparing table modes
+ */
+struct TableBuildReport {
+    TableMode mode = TableMode::CANONICAL_LR1;
+    size_t stateCount = 0;
+    size_t mergedStates = 0;   // states that absorbed more than one kernel
+    std::vector<TableConflict> conflicts;
+
+    size_t countConflicts(bool reduceReduce) const;
+};
+
+/**
+ * LR1TableBuilder
+ * LR(1) collection construction in one of three modes:
+ *
+ *   CANONICAL_LR1  one state per distinct LR(1) kernel (Knuth)
+ *   LALR1          states with the same LR(0) core are always merged
+ *   MINIMAL_LR1    same-core states are merged only when Pager's weak
+ *                  compatibility test holds, so merging never introduces
+ *                  a reduce/reduce conflict that canonical LR(1) lacks
+ *
+ * Closures and GOTO kernels are computed on a thread pool; the result
+ * does not depend on the number of threads. Only used while a ParseTable
+ * is being created; parsers never see the item sets.
+ */
+class LR1TableBuilder {
+public:
+    /**
+     * threads == 0 uses one thread per hardware thread
+     */
+    explicit LR1TableBuilder(const Grammar& g, TableMode mode = TableMode::CANONICAL_LR1,
+                             unsigned threads = 0);
+
+    // One row per state, one column per terminal / nonterminal id
+    using ActionRows = std::vector<std::vector<Action>>;
+    using GotoRows = std::vector<std::vector<int>>;
+
+    /**
+     * Fill the ACTION/GOTO tables; returns the number of states
+     */
+    size_t build(ActionRows& actionTable, GotoRows& gotoTable);
+
+    const TableBuildReport& getReport() const { return report; }
+
+private:
+    const Grammar& grammar;
+    const TableMode mode;
+    const unsigned threadCount;
+    TableBuildReport report;
+
+    // One entry per nonterminal B reachable by leftmost expansion of A:
+    // expanding A with lookaheads L yields [B -> ·δ, b] for every
+    // b in spontaneous ∪ (propagates ? L : ∅)
+    struct ClosureEntry {
+        int nonTerminal;
+        TerminalSet spontaneous;
+        bool propagates;
+    };
+    std::vector<std::vector<ClosureEntry>> closureTemplates;   // indexed by A
+
+    std::vector<std::set<LR1Item>> kernels;   // kernel of each state (grows when merged into)
+    std::vector<std::set<LR1Item>> states;    // closure of the current kernel
+    std::vector<std::vector<std::pair<GrammarSymbol, int>>> transitions;
+    std::vector<bool> merged;
+    std::vector<bool> queued;
+    std::vector<int> worklist;
+
+    // Kernel hash -> ids of the states with that hash (almost always one).
+    // Canonical mode hashes the full kernel, the merging modes its LR(0)
+    // core, so lookups happen before closure() and known states are never
+    // closed twice.
+    std::unordered_map<uint64_t, std::vector<int>> stateIndex;
+
+    static uint64_t hashItems(const std::set<LR1Item>& items, bool withLookaheads);
+
+    void computeClosureTemplates();
+
+    // Everything about one state that can be computed without touching
+    // the collection; produced in parallel, committed in order
+    struct Expansion {
+        std::set<LR1Item> items;                   // closure of the kernel
+        std::vector<GrammarSymbol> symbols;        // symbols after a dot, ascending
+        std::vector<std::set<LR1Item>> successors; // GOTO kernel per symbol
+        std::vector<uint64_t> hashes;              // stateIndex key per successor
+    };
+    Expansion expand(const std::set<LR1Item>& kernel) const;
+    void commit(int state, Expansion& expansion);
+
+    // Single pass over the kernel using closureTemplates; no fixed point
+    std::set<LR1Item> closure(const std::set<LR1Item>& items) const;
+
+    int findOrAddState(const std::set<LR1Item>& kernel, uint64_t hash);
+    void mergeInto(int state, const std::set<LR1Item>& kernel);
+    bool weaklyCompatible(const std::set<LR1Item>& a, const std::set<LR1Item>& b) const;
+
+    // Drop states orphaned by merging and number the rest breadth-first
+    std::vector<int> reachableOrder() const;
+};
+
+} // namespace SCERSE
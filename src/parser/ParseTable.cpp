@@ -0,0 +1,626 @@
+#include "ParseTable.hpp"
+#include "LR1TableBuilder.hpp"
+#include "../common/AST.hpp"
+#ifdef SCERSE_HAVE_GENERATED_TABLES
+#include "GeneratedParseTable.hpp"
+#endif
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+namespace SCERSE {
+
+namespace {
+
+/**
+ * Binary table file layout (native byte order):
+ *
+ *   TableFileHeader
+ *   int32_t        actions[stateCount * terminalCount]       DENSE32
+ *   int32_t        gotos[stateCount * nonTerminalCount]      DENSE32
+ *   int32_t        combBase[stateCount]                      COMB16
+ *   ProductionInfo productions[productionCount]
+ *   int32_t        terminalMap[tokenTypeCount]
+ *   int16_t        actions16[stateCount * terminalCount]     DENSE16
+ *   int16_t        gotos16[stateCount * nonTerminalCount]    DENSE16
+ *   int16_t        actionDefault[stateCount]                 COMB16
+ *   int16_t        gotoDefault[nonTerminalCount]             COMB16
+ *   int16_t        combCheck[combSize]                       COMB16
+ *   int16_t        combValue[combSize]                       COMB16
+ *
+ * Arrays of other encodings are absent. 32-bit arrays come first, so
+ * every array is naturally aligned inside the mapping.
+ *
+ * The magic doubles as a byte-order mark: a file written on a machine
+ * with the other endianness fails the magic check and is rebuilt.
+ */
+struct TableFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t grammarHash;
+    uint64_t checksum;          // FNV-1a over everything after the header
+    uint32_t stateCount;
+    uint32_t terminalCount;
+    uint32_t nonTerminalCount;
+    uint32_t productionCount;
+    uint32_t tokenTypeCount;
+    uint32_t mode;              // TableMode
+    uint32_t encoding;          // TableEncoding
+    uint32_t combSize;
+};
+
+constexpr uint32_t TABLE_FILE_MAGIC = 0x54504353;  // "SCPT"
+constexpr uint32_t TOKEN_TYPE_COUNT = static_cast<uint32_t>(TokenType::ERROR_TOKEN) + 1;
+
+uint64_t fnv1a(const char* data, size_t size) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Payload arrays, in file order
+enum Section {
+    ACTIONS, GOTOS, COMB_BASE, PRODUCTIONS, TERMINAL_MAP,
+    ACTIONS16, GOTOS16, ACTION_DEFAULT, GOTO_DEFAULT, COMB_CHECK, COMB_VALUE,
+    SECTION_COUNT
+};
+
+std::array<size_t, SECTION_COUNT> sectionSizes(const TableFileHeader& h) {
+    std::array<size_t, SECTION_COUNT> sizes{};
+    const size_t actionCells = static_cast<size_t>(h.stateCount) * h.terminalCount;
+    const size_t gotoCells = static_cast<size_t>(h.stateCount) * h.nonTerminalCount;
+
+    switch (static_cast<TableEncoding>(h.encoding)) {
+        case TableEncoding::DENSE32:
+            sizes[ACTIONS] = sizeof(int32_t) * actionCells;
+            sizes[GOTOS] = sizeof(int32_t) * gotoCells;
+            break;
+        case TableEncoding::DENSE16:
+            sizes[ACTIONS16] = sizeof(int16_t) * actionCells;
+            sizes[GOTOS16] = sizeof(int16_t) * gotoCells;
+            break;
+        case TableEncoding::COMB16:
+            sizes[COMB_BASE] = sizeof(int32_t) * h.stateCount;
+            sizes[ACTION_DEFAULT] = sizeof(int16_t) * h.stateCount;
+            sizes[GOTO_DEFAULT] = sizeof(int16_t) * h.nonTerminalCount;
+            sizes[COMB_CHECK] = sizeof(int16_t) * h.combSize;
+            sizes[COMB_VALUE] = sizeof(int16_t) * h.combSize;
+            break;
+    }
+    sizes[PRODUCTIONS] = sizeof(ProductionInfo) * h.productionCount;
+    sizes[TERMINAL_MAP] = sizeof(int32_t) * h.tokenTypeCount;
+    return sizes;
+}
+
+size_t payloadSize(const TableFileHeader& h) {
+    size_t total = 0;
+    for (size_t bytes : sectionSizes(h)) total += bytes;
+    return total;
+}
+
+const char* encodingName(TableEncoding encoding) {
+    switch (encoding) {
+        case TableEncoding::DENSE32: return "dense32";
+        case TableEncoding::DENSE16: return "dense16";
+        case TableEncoding::COMB16:  return "comb16";
+        default:                     return "unknown";
+    }
+}
+
+/**
+ * ACTION/GOTO cells in one encoding, ready to be written as file sections
+ */
+struct EncodedCells {
+    TableEncoding encoding = TableEncoding::DENSE32;
+    uint32_t combSize = 0;
+    std::vector<int32_t> actions, gotos, combBase;
+    std::vector<int16_t> actions16, gotos16, actionDefault, gotoDefault, combCheck, combValue;
+
+    size_t bytes() const {
+        return sizeof(int32_t) * (actions.size() + gotos.size() + combBase.size()) +
+               sizeof(int16_t) * (actions16.size() + gotos16.size() + actionDefault.size() +
+                                  gotoDefault.size() + combCheck.size() + combValue.size());
+    }
+};
+
+bool fitsInt16(int32_t value) {
+    return value >= INT16_MIN && value <= INT16_MAX;
+}
+
+bool encodeDense16(const std::vector<int32_t>& actionCells, const std::vector<int32_t>& gotoCells,
+                   EncodedCells& out) {
+    out.encoding = TableEncoding::DENSE16;
+    for (int32_t cell : actionCells) {
+        if (!fitsInt16(cell)) return false;
+        out.actions16.push_back(static_cast<int16_t>(cell));
+    }
+    for (int32_t target : gotoCells) {
+        if (!fitsInt16(target)) return false;
+        out.gotos16.push_back(static_cast<int16_t>(target));
+    }
+    return true;
+}
+
+bool encodeComb16(const std::vector<int32_t>& actionCells, const std::vector<int32_t>& gotoCells,
+                  size_t stateCount, size_t terminalCount, size_t nonTerminalCount,
+                  EncodedCells& out) {
+    out.encoding = TableEncoding::COMB16;
+    if (stateCount > INT16_MAX) return false;  // combCheck holds state numbers
+
+    // Default GOTO per nonterminal: its most common target (lowest on ties)
+    out.gotoDefault.assign(nonTerminalCount, -1);
+    for (size_t nt = 0; nt < nonTerminalCount; ++nt) {
+        std::map<int32_t, size_t> counts;
+        for (size_t state = 0; state < stateCount; ++state) {
+            int32_t target = gotoCells[state * nonTerminalCount + nt];
+            if (target >= 0) counts[target]++;
+        }
+        size_t best = 0;
+        for (const auto& entry : counts) {
+            if (entry.second > best) {
+                best = entry.second;
+                out.gotoDefault[nt] = static_cast<int16_t>(entry.first);
+            }
+        }
+    }
+
+    // Default action per state: the reduction, when it is the only thing
+    // the state can do. Everything else stays an explicit entry, so the
+    // error is still reported on the same token.
+    out.actionDefault.assign(stateCount, 0);
+    std::vector<std::vector<std::pair<size_t, int16_t>>> rows(stateCount);
+    for (size_t state = 0; state < stateCount; ++state) {
+        const int32_t* actions = &actionCells[state * terminalCount];
+        int32_t onlyReduce = 0;
+        bool single = true;
+        for (size_t t = 0; t < terminalCount; ++t) {
+            if (actions[t] == 0) continue;
+            if ((actions[t] & 3) == 2 && (onlyReduce == 0 || onlyReduce == actions[t])) {
+                onlyReduce = actions[t];
+            } else {
+                single = false;
+            }
+        }
+        if (single && onlyReduce != 0) {
+            if (!fitsInt16(onlyReduce)) return false;
+            out.actionDefault[state] = static_cast<int16_t>(onlyReduce);
+        }
+
+        for (size_t t = 0; t < terminalCount; ++t) {
+            if (actions[t] == 0 || actions[t] == out.actionDefault[state]) continue;
+            if (!fitsInt16(actions[t])) return false;
+            rows[state].emplace_back(t, static_cast<int16_t>(actions[t]));
+        }
+        for (size_t nt = 0; nt < nonTerminalCount; ++nt) {
+            int32_t target = gotoCells[state * nonTerminalCount + nt];
+            if (target < 0 || target == out.gotoDefault[nt]) continue;
+            if (!fitsInt16(target)) return false;
+            rows[state].emplace_back(terminalCount + nt, static_cast<int16_t>(target));
+        }
+    }
+
+    // First-fit packing, fullest rows first; ties keep state order, so the
+    // layout is reproducible
+    std::vector<size_t> order(stateCount);
+    for (size_t state = 0; state < stateCount; ++state) order[state] = state;
+    std::stable_sort(order.begin(), order.end(), [&rows](size_t a, size_t b) {
+        return rows[a].size() > rows[b].size();
+    });
+
+    out.combBase.assign(stateCount, 0);
+    std::vector<int16_t>& check = out.combCheck;
+    std::vector<int16_t>& value = out.combValue;
+    size_t firstFree = 0;
+
+    for (size_t state : order) {
+        const auto& row = rows[state];
+        if (row.empty()) continue;
+
+        size_t base = firstFree > row[0].first ? firstFree - row[0].first : 0;
+        for (;; ++base) {
+            bool fits = true;
+            for (const auto& entry : row) {
+                size_t i = base + entry.first;
+                if (i < check.size() && check[i] != -1) {
+                    fits = false;
+                    break;
+                }
+            }
+            if (fits) break;
+        }
+
+        for (const auto& entry : row) {
+            size_t i = base + entry.first;
+            if (i >= check.size()) {
+                check.resize(i + 1, -1);
+                value.resize(i + 1, 0);
+            }
+            check[i] = static_cast<int16_t>(state);
+            value[i] = entry.second;
+        }
+        out.combBase[state] = static_cast<int32_t>(base);
+        while (firstFree < check.size() && check[firstFree] != -1) ++firstFree;
+    }
+
+    // Pad so base + any column stays in range without a bounds check
+    size_t needed = check.size();
+    for (int32_t base : out.combBase) {
+        needed = std::max(needed, static_cast<size_t>(base) + terminalCount + nonTerminalCount);
+    }
+    check.resize(needed, -1);
+    value.resize(needed, 0);
+    out.combSize = static_cast<uint32_t>(needed);
+    return true;
+}
+
+std::string& cacheFilePath() {
+    static std::string path;
+    return path;
+}
+
+TableMode& configuredMode() {
+    static TableMode mode = TableMode::MINIMAL_LR1;
+    return mode;
+}
+
+} // namespace
+
+int32_t ParseTable::encodeAction(const Action& action) {
+    switch (action.type) {
+        case ActionType::SHIFT:  return (action.value << 2) | 1;
+        case ActionType::REDUCE: return (action.value << 2) | 2;
+        case ActionType::ACCEPT: return 3;
+        case ActionType::ERROR:
+        default:                 return 0;
+    }
+}
+
+Action ParseTable::decodeAction(int32_t cell) {
+    switch (cell & 3) {
+        case 1:  return Action(ActionType::SHIFT, cell >> 2);
+        case 2:  return Action(ActionType::REDUCE, cell >> 2);
+        case 3:  return Action(ActionType::ACCEPT, 0);
+        default: return Action();
+    }
+}
+
+void ParseTable::setCacheFile(const std::string& path) {
+    cacheFilePath() = path;
+}
+
+void ParseTable::setDefaultMode(TableMode mode) {
+    configuredMode() = mode;
+}
+
+TableMode ParseTable::defaultMode() {
+    return configuredMode();
+}
+
+std::shared_ptr<const ParseTable> ParseTable::shared() {
+    // Function-local static: constructed exactly once, even under concurrent first use
+    static const std::shared_ptr<const ParseTable> instance = []() {
+        if (auto table = embedded()) return table;
+        return cacheFilePath().empty() ? build() : loadOrBuild(cacheFilePath());
+    }();
+    return instance;
+}
+
+std::shared_ptr<const ParseTable> ParseTable::embedded() {
+#ifdef SCERSE_HAVE_GENERATED_TABLES
+    std::shared_ptr<ParseTable> table(new ParseTable());
+    if (table->attach(GeneratedTables::PARSE_TABLE)) {
+        if (table->getMode() == defaultMode()) return table;
+        std::cout << "Generated parse tables are " << to_cstring(table->getMode())
+                  << ", " << to_cstring(defaultMode()) << " requested - ignoring them" << std::endl;
+        return nullptr;
+    }
+    // The generator runs on every change to the parser sources, so this only
+    // happens if the generated header was produced from a different grammar
+    std::cerr << "WARNING: Generated parse tables do not match Grammar.cpp "
+              << "(hash " << GeneratedTables::PARSE_TABLE.grammarHash << " vs "
+              << table->grammar.getContentHash() << ") - ignoring them" << std::endl;
+#endif
+    return nullptr;
+}
+
+std::shared_ptr<const ParseTable> ParseTable::build() {
+    return build(defaultMode());
+}
+
+std::shared_ptr<const ParseTable> ParseTable::build(TableMode mode, TableBuildReport* report,
+                                                   unsigned threads) {
+    std::cout << "=== LR1 Parse Table Construction (" << to_cstring(mode) << ") ===" << std::endl;
+
+    std::shared_ptr<ParseTable> table(new ParseTable());
+    const Grammar& grammar = table->grammar;
+
+    LR1TableBuilder::ActionRows actionRows;
+    LR1TableBuilder::GotoRows gotoRows;
+    TableBuildReport summary;
+    size_t states = 0;
+
+    try {
+        LR1TableBuilder builder(grammar, mode, threads);
+        states = builder.build(actionRows, gotoRows);
+        summary = builder.getReport();
+    } catch (const std::exception& ex) {
+        std::cerr << "ERROR building parser table: " << ex.what() << std::endl;
+        actionRows.clear();
+        gotoRows.clear();
+        states = 0;
+    }
+
+    TableFileHeader header{};
+    header.magic = TABLE_FILE_MAGIC;
+    header.version = FILE_VERSION;
+    header.grammarHash = grammar.getContentHash();
+    header.stateCount = static_cast<uint32_t>(states);
+    header.terminalCount = static_cast<uint32_t>(grammar.getTerminalCount());
+    header.nonTerminalCount = static_cast<uint32_t>(grammar.getNonTerminalCount());
+    header.productionCount = static_cast<uint32_t>(grammar.getProductionCount());
+    header.tokenTypeCount = TOKEN_TYPE_COUNT;
+    header.mode = static_cast<uint32_t>(mode);
+
+    std::vector<int32_t> actionCells(static_cast<size_t>(header.stateCount) * header.terminalCount, 0);
+    std::vector<int32_t> gotoCells(static_cast<size_t>(header.stateCount) * header.nonTerminalCount, -1);
+    std::vector<ProductionInfo> productionCells;
+    std::vector<int32_t> terminalCells(TOKEN_TYPE_COUNT, -1);
+
+    // Columns are the grammar's dense symbol ids
+    for (size_t state = 0; state < header.stateCount; ++state) {
+        for (size_t t = 0; t < header.terminalCount; ++t) {
+            actionCells[state * header.terminalCount + t] = encodeAction(actionRows[state][t]);
+        }
+        for (size_t nt = 0; nt < header.nonTerminalCount; ++nt) {
+            gotoCells[state * header.nonTerminalCount + nt] = gotoRows[state][nt];
+        }
+    }
+    for (const auto& production : grammar.getProductions()) {
+        ProductionInfo info;
+        info.lhs = production.lhs.id;
+        info.rhsLength = static_cast<int32_t>(production.rhs.size());
+        info.nodeKind = static_cast<int32_t>(production.action.type);
+        productionCells.push_back(info);
+    }
+    for (uint32_t tt = 0; tt < TOKEN_TYPE_COUNT; ++tt) {
+        terminalCells[tt] = grammar.terminalForToken(static_cast<TokenType>(tt));
+    }
+
+    // Keep whichever encoding that fits takes the fewest bytes
+    EncodedCells cells;
+    cells.actions = actionCells;
+    cells.gotos = gotoCells;
+    const size_t denseBytes = cells.bytes();
+
+    EncodedCells dense16;
+    if (encodeDense16(actionCells, gotoCells, dense16) && dense16.bytes() < cells.bytes()) {
+        cells = std::move(dense16);
+    }
+    EncodedCells comb16;
+    if (encodeComb16(actionCells, gotoCells, header.stateCount, header.terminalCount,
+                     header.nonTerminalCount, comb16) && comb16.bytes() < cells.bytes()) {
+        cells = std::move(comb16);
+    }
+    header.encoding = static_cast<uint32_t>(cells.encoding);
+    header.combSize = cells.combSize;
+
+    // Assemble the file image (uint64_t storage keeps the header aligned)
+    size_t payload = payloadSize(header);
+    table->image.assign((sizeof(TableFileHeader) + payload + 7) / 8, 0);
+    char* out = reinterpret_cast<char*>(table->image.data()) + sizeof(TableFileHeader);
+
+    const void* sources[SECTION_COUNT] = {
+        cells.actions.data(), cells.gotos.data(), cells.combBase.data(),
+        productionCells.data(), terminalCells.data(),
+        cells.actions16.data(), cells.gotos16.data(), cells.actionDefault.data(),
+        cells.gotoDefault.data(), cells.combCheck.data(), cells.combValue.data()
+    };
+    const auto sizes = sectionSizes(header);
+    for (size_t section = 0; section < SECTION_COUNT; ++section) {
+        if (sizes[section]) std::memcpy(out, sources[section], sizes[section]);
+        out += sizes[section];
+    }
+
+    const char* imageBytes = reinterpret_cast<const char*>(table->image.data());
+    header.checksum = fnv1a(imageBytes + sizeof(TableFileHeader), payload);
+    std::memcpy(table->image.data(), &header, sizeof(header));
+
+    if (!table->attachImage(imageBytes, sizeof(TableFileHeader) + payload)) {
+        std::cerr << "ERROR: Generated parse table failed validation" << std::endl;
+    }
+
+    std::cout << "✓ States: " << table->getStateCount() << std::endl;
+    std::cout << "✓ Encoding: " << encodingName(table->getEncoding()) << ", "
+              << table->getTableBytes() << " bytes (dense32 " << denseBytes << ")" << std::endl;
+    if (!summary.conflicts.empty()) {
+        size_t inMerged = 0;
+        for (const auto& conflict : summary.conflicts) {
+            if (conflict.mergedState) ++inMerged;
+        }
+        std::cout << "✓ Conflicts: " << summary.countConflicts(false) << " shift/reduce, "
+                  << summary.countConflicts(true) << " reduce/reduce ("
+                  << inMerged << " in merged states)" << std::endl;
+    }
+    std::cout << "✓ Terminals: " << table->getTerminalCount()
+              << ", Nonterminals: " << table->getNonTerminalCount() << std::endl;
+
+    if (table->getStateCount() == 0) {
+        std::cerr << "WARNING: No parser states generated!" << std::endl;
+    }
+
+    std::cout << "=================================\n" << std::endl;
+    if (report) *report = summary;
+    return table;
+}
+
+bool ParseTable::attach(const ParseTableData& tables) {
+    data = ParseTableData();
+
+    if (tables.grammarHash != grammar.getContentHash()) return false;
+    if (tables.tokenTypeCount != TOKEN_TYPE_COUNT ||
+        tables.terminalCount != grammar.getTerminalCount() ||
+        tables.nonTerminalCount != grammar.getNonTerminalCount() ||
+        tables.productionCount != grammar.getProductionCount()) {
+        return false;
+    }
+    if (!tables.productions || !tables.terminalMap) return false;
+    if (tables.mode > static_cast<uint32_t>(TableMode::MINIMAL_LR1)) return false;
+
+    if (tables.stateCount > 0) {
+        switch (static_cast<TableEncoding>(tables.encoding)) {
+            case TableEncoding::DENSE32:
+                if (!tables.actions || !tables.gotos) return false;
+                break;
+            case TableEncoding::DENSE16:
+                if (!tables.actions16 || !tables.gotos16) return false;
+                break;
+            case TableEncoding::COMB16: {
+                if (!tables.combBase || !tables.combCheck || !tables.combValue ||
+                    !tables.actionDefault || !tables.gotoDefault) {
+                    return false;
+                }
+                // Lookups skip the range check, so every row must fit
+                const size_t width = static_cast<size_t>(tables.terminalCount) + tables.nonTerminalCount;
+                for (uint32_t state = 0; state < tables.stateCount; ++state) {
+                    if (tables.combBase[state] < 0 ||
+                        static_cast<size_t>(tables.combBase[state]) + width > tables.combSize) {
+                        return false;
+                    }
+                }
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+
+    data = tables;
+    return true;
+}
+
+size_t ParseTable::getTableBytes() const {
+    const size_t cells = static_cast<size_t>(data.stateCount) * (data.terminalCount + data.nonTerminalCount);
+    switch (getEncoding()) {
+        case TableEncoding::DENSE32: return sizeof(int32_t) * cells;
+        case TableEncoding::DENSE16: return sizeof(int16_t) * cells;
+        case TableEncoding::COMB16:
+            return sizeof(int32_t) * data.stateCount +
+                   sizeof(int16_t) * (data.stateCount + data.nonTerminalCount + 2 * static_cast<size_t>(data.combSize));
+        default: return 0;
+    }
+}
+
+bool ParseTable::attachImage(const char* bytes, size_t size) {
+    if (!bytes || size < sizeof(TableFileHeader)) return false;
+
+    TableFileHeader header;
+    std::memcpy(&header, bytes, sizeof(header));
+
+    if (header.magic != TABLE_FILE_MAGIC || header.version != FILE_VERSION) return false;
+    if (header.encoding > static_cast<uint32_t>(TableEncoding::COMB16)) return false;
+
+    size_t payload = payloadSize(header);
+    if (size != sizeof(TableFileHeader) + payload) return false;
+    if (fnv1a(bytes + sizeof(TableFileHeader), payload) != header.checksum) return false;
+
+    ParseTableData tables;
+    tables.grammarHash = header.grammarHash;
+    tables.stateCount = header.stateCount;
+    tables.terminalCount = header.terminalCount;
+    tables.nonTerminalCount = header.nonTerminalCount;
+    tables.productionCount = header.productionCount;
+    tables.tokenTypeCount = header.tokenTypeCount;
+    tables.mode = header.mode;
+    tables.encoding = header.encoding;
+    tables.combSize = header.combSize;
+
+    // Absent sections stay nullptr
+    const char* section[SECTION_COUNT] = {};
+    const char* cursor = bytes + sizeof(TableFileHeader);
+    const auto sizes = sectionSizes(header);
+    for (size_t i = 0; i < SECTION_COUNT; ++i) {
+        if (sizes[i]) section[i] = cursor;
+        cursor += sizes[i];
+    }
+    tables.actions = reinterpret_cast<const int32_t*>(section[ACTIONS]);
+    tables.gotos = reinterpret_cast<const int32_t*>(section[GOTOS]);
+    tables.combBase = reinterpret_cast<const int32_t*>(section[COMB_BASE]);
+    tables.productions = reinterpret_cast<const ProductionInfo*>(section[PRODUCTIONS]);
+    tables.terminalMap = reinterpret_cast<const int32_t*>(section[TERMINAL_MAP]);
+    tables.actions16 = reinterpret_cast<const int16_t*>(section[ACTIONS16]);
+    tables.gotos16 = reinterpret_cast<const int16_t*>(section[GOTOS16]);
+    tables.actionDefault = reinterpret_cast<const int16_t*>(section[ACTION_DEFAULT]);
+    tables.gotoDefault = reinterpret_cast<const int16_t*>(section[GOTO_DEFAULT]);
+    tables.combCheck = reinterpret_cast<const int16_t*>(section[COMB_CHECK]);
+    tables.combValue = reinterpret_cast<const int16_t*>(section[COMB_VALUE]);
+
+    return attach(tables);
+}
+
+std::shared_ptr<const ParseTable> ParseTable::load(const std::string& path) {
+    std::shared_ptr<ParseTable> table(new ParseTable());
+
+    if (!table->file.open(path)) return nullptr;
+
+    if (!table->attachImage(table->file.data(), table->file.size())) {
+        std::cerr << "Parse table file " << path << " is stale or corrupt - ignoring it" << std::endl;
+        return nullptr;
+    }
+    if (table->getMode() != defaultMode()) {
+        std::cout << "Parse table file " << path << " holds " << to_cstring(table->getMode())
+                  << " tables - rebuilding as " << to_cstring(defaultMode()) << std::endl;
+        return nullptr;
+    }
+    return table;
+}
+
+std::shared_ptr<const ParseTable> ParseTable::loadOrBuild(const std::string& path) {
+    if (auto table = load(path)) {
+        std::cout << "✓ Parse table mapped from " << path
+                  << " (" << table->getStateCount() << " states)" << std::endl;
+        return table;
+    }
+
+    auto table = build();
+    if (table->getStateCount() > 0 && !table->save(path)) {
+        std::cerr << "WARNING: Could not write parse table file " << path << std::endl;
+    }
+    return table;
+}
+
+bool ParseTable::save(const std::string& path) const {
+    const char* data = nullptr;
+    size_t size = 0;
+    if (file.isOpen()) {
+        data = file.data();
+        size = file.size();
+    } else if (!image.empty()) {
+        data = reinterpret_cast<const char*>(image.data());
+        size = sizeof(TableFileHeader) + payloadSize(*reinterpret_cast<const TableFileHeader*>(data));
+    }
+    if (!data) return false;
+
+    // Write next to the target and rename, so readers never see a partial file
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        out.write(data, static_cast<std::streamsize>(size));
+        if (!out) return false;
+    }
+
+#ifdef _WIN32
+    std::remove(path.c_str());  // rename() does not replace existing files on Windows
+#endif
+    return std::rename(tmpPath.c_str(), path.c_str()) == 0;
+}
+
+} // namespace SCERSE
@@ -0,0 +1,231 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Grammar.hpp"
+#include "LR1TableBuilder.hpp"
+#include "../common/MappedFile.hpp"
+
+namespace SCERSE {
+
+/**
+ * ProductionInfo
+ * What the parse loop needs to know about a production on a reduce
+ */
+struct ProductionInfo {
+    int32_t lhs;         // Nonterminal column in the GOTO table
+    int32_t rhsLength;   // Number of stack entries to pop
+    int32_t nodeKind;    // ASTNodeType its SemanticAction builds (EMPTY = pass-through)
+};
+
+/**
+ * TableEncoding
+ * How the ACTION/GOTO cells are stored. build() encodes the tables every
+ * way that fits and keeps the smallest.
+ */
+enum class TableEncoding : uint32_t {
+    DENSE32 = 0,   // int32 rows; any table size
+    DENSE16 = 1,   // int16 rows; needs fewer than 8192 states and productions
+    COMB16 = 2     // int16 row displacement (comb vector) with per-state
+                   // default reductions and per-nonterminal default gotos
+};
+
+/**
+ * ParseTableData
+ * Raw tables plus the sizes needed to index them. Points into a freshly
+ * built image, a mapped table file, or the constexpr arrays that
+ * scerse_tablegen emits at build time. Only the arrays of the chosen
+ * encoding are set.
+ */
+struct ParseTableData {
+    uint64_t grammarHash = 0;
+    uint32_t stateCount = 0;
+    uint32_t terminalCount = 0;
+    uint32_t nonTerminalCount = 0;
+    uint32_t productionCount = 0;
+    uint32_t tokenTypeCount = 0;
+    uint32_t mode = 0;                          // TableMode the states were built with
+    uint32_t encoding = 0;                      // TableEncoding
+    uint32_t combSize = 0;                      // entries in combCheck/combValue
+
+    const ProductionInfo* productions = nullptr;
+    const int32_t* terminalMap = nullptr;       // indexed by TokenType
+
+    // DENSE32 / DENSE16: stateCount x terminalCount, stateCount x nonTerminalCount
+    const int32_t* actions = nullptr;
+    const int32_t* gotos = nullptr;
+    const int16_t* actions16 = nullptr;
+    const int16_t* gotos16 = nullptr;
+
+    // COMB16: each state's row covers the terminal columns followed by the
+    // nonterminal columns; an entry belongs to the row if check == state
+    const int32_t* combBase = nullptr;          // [stateCount]
+    const int16_t* combCheck = nullptr;         // [combSize] owning state, -1 if free
+    const int16_t* combValue = nullptr;         // [combSize] action cell or goto target
+    const int16_t* actionDefault = nullptr;     // [stateCount] cell for absent terminals
+    const int16_t* gotoDefault = nullptr;       // [nonTerminalCount] target for absent gotos
+};
+
+/**
+ * ParseTable
+ * Immutable LR(1) ACTION/GOTO tables together with the grammar they were
+ * built from. The states come from canonical LR(1), LALR(1) or minimal
+ * LR(1) construction (see LR1TableBuilder); all three parse the same
+ * language as long as the merging modes report no new conflicts.
+ * Nothing is modified after construction, so one instance can be shared
+ * by any number of LR1Parser objects on any number of threads.
+ *
+ * The cells are stored in one of three TableEncodings, whichever is
+ * smallest: DENSE32 or DENSE16 rows (one cell per state and symbol), or
+ * COMB16, where the rows overlap in one comb vector and absent cells fall
+ * back to a per-state default reduction or a per-nonterminal default
+ * goto. getAction() and getGoto() switch on the encoding. Every encoding
+ * is laid out exactly like the binary table file, so a table loaded from
+ * disk is used straight out of the read-only mapping.
+ */
+class ParseTable {
+public:
+    // Bump whenever the binary layout below changes
+    static constexpr uint32_t FILE_VERSION = 3;
+
+    /**
+     * Process-wide table, created on first use.
+     * Initialization is thread-safe; later calls only copy the pointer.
+     * Uses the cache file configured with setCacheFile(), if any.
+     */
+    static std::shared_ptr<const ParseTable> shared();
+
+    /**
+     * Binary table file used by shared(); must be set before the first call
+     */
+    static void setCacheFile(const std::string& path);
+
+    /**
+     * Construction mode used by shared(), build(), embedded() and load().
+     * Defaults to MINIMAL_LR1; must be set before the first shared() call.
+     * Embedded or cached tables built in another mode are ignored.
+     */
+    static void setDefaultMode(TableMode mode);
+    static TableMode defaultMode();
+
+    /**
+     * Run the table construction over the grammar in Grammar.cpp.
+     * State counts and conflicts are copied to 'report' when given.
+     * threads == 0 uses every hardware thread; the tables are the same
+     * for any thread count.
+     */
+    static std::shared_ptr<const ParseTable> build();
+    static std::shared_ptr<const ParseTable> build(TableMode mode, TableBuildReport* report = nullptr,
+                                                   unsigned threads = 0);
+
+    /**
+     * Table compiled into the binary by scerse_tablegen. Returns nullptr
+     * when the build has no generated tables or they no longer match
+     * the grammar in Grammar.cpp.
+     */
+    static std::shared_ptr<const ParseTable> embedded();
+
+    /**
+     * Map a binary table file. Returns nullptr if the file is missing,
+     * corrupt, from another format version or from a different grammar.
+     */
+    static std::shared_ptr<const ParseTable> load(const std::string& path);
+
+    /**
+     * load(), falling back to build() + save() when the file is unusable
+     */
+    static std::shared_ptr<const ParseTable> loadOrBuild(const std::string& path);
+
+    /**
+     * Write the table in the binary format (atomically replaces the file)
+     */
+    bool save(const std::string& path) const;
+
+    const Grammar& getGrammar() const { return grammar; }
+    const ParseTableData& getData() const { return data; }
+    size_t getStateCount() const { return data.stateCount; }
+    size_t getTerminalCount() const { return data.terminalCount; }
+    size_t getNonTerminalCount() const { return data.nonTerminalCount; }
+    TableMode getMode() const { return static_cast<TableMode>(data.mode); }
+    TableEncoding getEncoding() const { return static_cast<TableEncoding>(data.encoding); }
+
+    /**
+     * Bytes taken by the ACTION/GOTO cells in the chosen encoding
+     */
+    size_t getTableBytes() const;
+    bool isMapped() const { return file.isOpen(); }
+
+    /**
+     * ACTION column for a token type; -1 if the grammar has no such terminal
+     */
+    int terminalIndex(TokenType type) const {
+        int t = static_cast<int>(type);
+        return (t >= 0 && t < static_cast<int>(data.tokenTypeCount)) ? data.terminalMap[t] : -1;
+    }
+
+    /**
+     * ACTION[state, terminal]; ActionType::ERROR for an empty entry.
+     * With COMB16 a state whose only action is one reduction reduces on
+     * every terminal; the error then surfaces before the token is shifted.
+     */
+    Action getAction(int state, int terminal) const {
+        return decodeAction(actionCell(state, terminal));
+    }
+
+    /**
+     * GOTO[state, nonTerminal]; -1 if there is no transition. COMB16 tables
+     * return the column default instead, which is only wrong for entries
+     * a valid parse never asks for.
+     */
+    int getGoto(int state, int nonTerminal) const {
+        switch (static_cast<TableEncoding>(data.encoding)) {
+            case TableEncoding::COMB16: {
+                size_t i = static_cast<size_t>(data.combBase[state]) + data.terminalCount + nonTerminal;
+                return data.combCheck[i] == state ? data.combValue[i] : data.gotoDefault[nonTerminal];
+            }
+            case TableEncoding::DENSE16:
+                return data.gotos16[static_cast<size_t>(state) * data.nonTerminalCount + nonTerminal];
+            default:
+                return data.gotos[static_cast<size_t>(state) * data.nonTerminalCount + nonTerminal];
+        }
+    }
+
+    const ProductionInfo& getProductionInfo(int productionId) const {
+        return data.productions[productionId];
+    }
+
+    // Encoded ACTION cell: kind in the low two bits, state/production above
+    static int32_t encodeAction(const Action& action);
+    static Action decodeAction(int32_t cell);
+
+    int32_t actionCell(int state, int terminal) const {
+        switch (static_cast<TableEncoding>(data.encoding)) {
+            case TableEncoding::COMB16: {
+                size_t i = static_cast<size_t>(data.combBase[state]) + terminal;
+                return data.combCheck[i] == state ? data.combValue[i] : data.actionDefault[state];
+            }
+            case TableEncoding::DENSE16:
+                return data.actions16[static_cast<size_t>(state) * data.terminalCount + terminal];
+            default:
+                return data.actions[static_cast<size_t>(state) * data.terminalCount + terminal];
+        }
+    }
+
+private:
+    ParseTable() = default;
+
+    Grammar grammar;
+
+    ParseTableData data;           // views into 'image', 'file' or static arrays
+
+    std::vector<uint64_t> image;   // file image of a freshly built table
+    MappedFile file;               // backing store of a loaded table
+
+    bool attach(const ParseTableData& tables);
+    bool attachImage(const char* bytes, size_t size);
+};
+
+} // namespace SCERSE
@@ -1,39 +1,211 @@
-#include "SuggestionEngine.hpp"
-#include <algorithm>
-#include <cmath>
-
-using namespace SCERSE;
-
-std::vector<std::string> SuggestionEngine::generateSuggestions(
-    const std::vector<CompilerError>& errors, const SymbolTable& symbolTable) {
-
-    std::vector<std::string> suggestions;
-
-    for (const auto& err : errors) {
-        std::string suggestion;
-        
-        if (err.message.find("undeclared") != std::string::npos) {
-            auto symbols = symbolTable.getAllSymbols();
-            std::string closest;
-            int best = 9999;
-            for (const auto& sym : symbols) {
-                int d = std::abs((int)err.message.size() - (int)sym.name.size());
-                if (d < best) {
-                    best = d;
-                    closest = sym.name;
-                }
-            }
-            suggestion = "[Line " + std::to_string(err.position.line) + "] Did you mean '" + closest + "'?";
-        }
-        else if (err.message.find("missing ;") != std::string::npos) {
-            suggestion = "[Line " + std::to_string(err.position.line) + "] Add a semicolon ';' at the end of the statement.";
-        }
-        else {
-            suggestion = "[Line " + std::to_string(err.position.line) + "] Check syntax near this line.";
-        }
-        
-        suggestions.push_back(suggestion);
-    }
-    return suggestions;
-}
-
+#include "SuggestionEngine.hpp"
+#include <algorithm>
+#include <cmath>
+
+using namespace SCERSE;
+
+namespace {
+
+// How a token type reads in a suggestion
+std::string spell(TokenType type) {
+    switch (type) {
+        case TokenType::INTEGER: return "a number";
+        case TokenType::FLOAT: return "a number";
+        case TokenType::STRING: return "a string";
+        case TokenType::BOOLEAN: return "a boolean";
+        case TokenType::IDENTIFIER: return "a name";
+        case TokenType::IF: return "'if'";
+        case TokenType::ELSE: return "'else'";
+        case TokenType::WHILE: return "'while'";
+        case TokenType::FOR: return "'for'";
+        case TokenType::FUNCTION: return "'function'";
+        case TokenType::RETURN: return "'return'";
+        case TokenType::VAR: return "'var'";
+        case TokenType::CONST: return "'const'";
+        case TokenType::TRUE: return "'true'";
+        case TokenType::FALSE: return "'false'";
+        case TokenType::INT: return "'int'";
+        case TokenType::FLOAT_KW: return "'float'";
+        case TokenType::STRING_KW: return "'string'";
+        case TokenType::BOOL: return "'bool'";
+        case TokenType::VOID: return "'void'";
+        case TokenType::PLUS: return "'+'";
+        case TokenType::MINUS: return "'-'";
+        case TokenType::MULTIPLY: return "'*'";
+        case TokenType::DIVIDE: return "'/'";
+        case TokenType::MODULO: return "'%'";
+        case TokenType::ASSIGN: return "'='";
+        case TokenType::EQUAL: return "'=='";
+        case TokenType::NOT_EQUAL: return "'!='";
+        case TokenType::LESS: return "'<'";
+        case TokenType::LESS_EQUAL: return "'<='";
+        case TokenType::GREATER: return "'>'";
+        case TokenType::GREATER_EQUAL: return "'>='";
+        case TokenType::LOGICAL_AND: return "'&&'";
+        case TokenType::LOGICAL_OR: return "'||'";
+        case TokenType::LOGICAL_NOT: return "'!'";
+        case TokenType::LEFT_PAREN: return "'('";
+        case TokenType::RIGHT_PAREN: return "')'";
+        case TokenType::LEFT_BRACE: return "'{'";
+        case TokenType::RIGHT_BRACE: return "'}'";
+        case TokenType::LEFT_BRACKET: return "'['";
+        case TokenType::RIGHT_BRACKET: return "']'";
+        case TokenType::SEMICOLON: return "';'";
+        case TokenType::COMMA: return "','";
+        case TokenType::DOT: return "'.'";
+        case TokenType::EOF_TOKEN: return "the end of the file";
+        default: return tokenTypeToString(type);
+    }
+}
+
+std::string spell(const Token& token) {
+    if (token.type == TokenType::EOF_TOKEN) return spell(token.type);
+    return "'" + std::string(token.lexeme) + "'";
+}
+
+} // namespace
+
+std::string Repair::describe(const std::vector<Token>& tokens) const {
+    const Token& at = tokens[tokenIndex];
+    switch (kind) {
+        case Kind::INSERT:
+            return "Insert " + spell(type) + " before " + spell(at) + ".";
+        case Kind::REPLACE:
+            return "Replace " + spell(at) + " with " + spell(type) + ".";
+        case Kind::DELETE:
+        default:
+            return "Remove " + spell(at) + ".";
+    }
+}
+
+std::vector<std::string> SuggestionEngine::generateSuggestions(
+    const std::vector<CompilerError>& errors, const SymbolTable& symbolTable) {
+    return generateSuggestions(errors, symbolTable, std::vector<Token>());
+}
+
+std::vector<std::string> SuggestionEngine::generateSuggestions(
+    const std::vector<CompilerError>& errors, const SymbolTable& symbolTable,
+    const std::vector<Token>& tokens) {
+
+    std::vector<std::string> suggestions;
+    std::vector<Repair> repairs;
+    if (!errors.empty() && !tokens.empty()) repairs = findRepairs(tokens);
+
+    for (const auto& err : errors) {
+        std::string suggestion;
+
+        // Parser errors carry the offending token's position
+        auto repair = std::find_if(repairs.begin(), repairs.end(), [&](const Repair& r) {
+            return r.position.line == err.position.line && r.position.column == err.position.column;
+        });
+
+        if (repair != repairs.end()) {
+            suggestion = "[Line " + std::to_string(err.position.line) + "] " + repair->describe(tokens);
+            repairs.erase(repair);
+        }
+        else if (err.message.find("undeclared") != std::string::npos) {
+            auto symbols = symbolTable.getAllSymbols();
+            std::string closest;
+            int best = 9999;
+            for (const auto& sym : symbols) {
+                int d = std::abs((int)err.message.size() - (int)sym.name.size());
+                if (d < best) {
+                    best = d;
+                    closest = sym.name;
+                }
+            }
+            suggestion = "[Line " + std::to_string(err.position.line) + "] Did you mean '" + closest + "'?";
+        }
+        else if (err.message.find("missing ;") != std::string::npos) {
+            suggestion = "[Line " + std::to_string(err.position.line) + "] Add a semicolon ';' at the end of the statement.";
+        }
+        else {
+            suggestion = "[Line " + std::to_string(err.position.line) + "] Check syntax near this line.";
+        }
+
+        suggestions.push_back(suggestion);
+    }
+    return suggestions;
+}
+
+std::vector<Repair> SuggestionEngine::findRepairs(const std::vector<Token>& tokens) const {
+    std::vector<Repair> repairs;
+    ParseState state;
+
+    for (int errorCount = 0; errorCount < LR1Parser::MAX_ERRORS; ++errorCount) {
+        RecognizeStatus status = parser.recognize(state, tokens.data(), tokens.size());
+        if (status != RecognizeStatus::ERROR || state.position >= tokens.size()) break;
+
+        // 'state' is the configuration at the error; it is only read
+        // while candidates are tried
+        Repair repair;
+        if (searchRepair(state, tokens, repair)) repairs.push_back(repair);
+
+        // Recover like LR1Parser: drop the offending token, keep the stack
+        ++state.position;
+    }
+    return repairs;
+}
+
+bool SuggestionEngine::searchRepair(const ParseState& snapshot, const std::vector<Token>& tokens,
+                                    Repair& best) const {
+    const auto deadline = std::chrono::steady_clock::now() + budget;
+    const size_t at = snapshot.position;
+    const bool atEnd = tokens[at].type == TokenType::EOF_TOKEN;
+
+    // Candidate input: an optional new token, then the original tokens
+    // from 'resume' on, up to the validation window. Only types matter
+    // to the automaton, so lexemes are not copied.
+    std::vector<Token> window;
+    window.reserve(VALIDATION_WINDOW + 1);
+    auto tryCandidate = [&](Repair::Kind kind, TokenType type, size_t resume) {
+        window.clear();
+        if (kind != Repair::Kind::DELETE) window.push_back(Token(type));
+        const size_t inserted = window.size();
+        for (size_t i = resume; i < tokens.size() && window.size() < inserted + VALIDATION_WINDOW; ++i) {
+            window.push_back(Token(tokens[i].type));
+        }
+
+        size_t consumed = 0;
+        RecognizeStatus status = parser.probe(snapshot, window.data(), window.size(), consumed);
+        if (status == RecognizeStatus::ERROR) return;
+        // NEED_INPUT only counts with a full window; a short one ends at
+        // EOF and must have been accepted
+        if (status == RecognizeStatus::NEED_INPUT && window.size() < inserted + VALIDATION_WINDOW) return;
+
+        size_t validated = window.size() - inserted;
+        if (validated > best.validated) {
+            best.kind = kind;
+            best.type = type;
+            best.validated = validated;
+        }
+    };
+
+    best = Repair();
+    best.tokenIndex = at;
+    best.position = tokens[at].position;
+
+    // Terminals the grammar knows (EOF is never inserted)
+    const ParseTable& table = parser.getTable();
+    std::vector<TokenType> candidates;
+    for (int t = 0; t < static_cast<int>(TokenType::ERROR_TOKEN); ++t) {
+        TokenType type = static_cast<TokenType>(t);
+        if (type != TokenType::EOF_TOKEN && table.terminalIndex(type) >= 0) candidates.push_back(type);
+    }
+
+    // Among equally good fixes the first one found wins: insertions, then
+    // replacements, then deleting the token
+    for (TokenType type : candidates) {
+        if (std::chrono::steady_clock::now() > deadline) return best.validated > 0;
+        tryCandidate(Repair::Kind::INSERT, type, at);
+    }
+    if (atEnd) return best.validated > 0;
+
+    for (TokenType type : candidates) {
+        if (type == tokens[at].type) continue;
+        if (std::chrono::steady_clock::now() > deadline) return best.validated > 0;
+        tryCandidate(Repair::Kind::REPLACE, type, at + 1);
+    }
+    tryCandidate(Repair::Kind::DELETE, TokenType::ERROR_TOKEN, at + 1);
+    return best.validated > 0;
+}
@@ -1,13 +1,69 @@
-#pragma once
-#include "../common/Error.hpp"
-#include "../semantic/SymbolTable.hpp"
-#include <string>
-#include <vector>
-
-namespace SCERSE {
-class SuggestionEngine {
-public:
-    std::vector<std::string> generateSuggestions(const std::vector<CompilerError>& errors,
-                                                const SymbolTable& symbolTable);
-};
-}
+#pragma once
+#include "../common/Error.hpp"
+#include "../semantic/SymbolTable.hpp"
+#include "../lexer/Token.hpp"
+#include "../parser/LR1Parser.hpp"
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace SCERSE {
+
+/**
+ * Repair
+ * One-token fix for a syntax error, found by trying edits at the error
+ * point and kept only if the parser then gets through the next tokens
+ */
+struct Repair {
+    enum class Kind { INSERT, REPLACE, DELETE };
+
+    Kind kind = Kind::INSERT;
+    size_t tokenIndex = 0;                 // offending token (insertions go before it)
+    TokenType type = TokenType::ERROR_TOKEN;   // inserted / replacement token
+    Position position;                     // of the offending token
+    size_t validated = 0;                  // tokens parsed after the fix
+
+    std::string describe(const std::vector<Token>& tokens) const;
+};
+
+class SuggestionEngine {
+public:
+    /**
+     * Suggestions from the error messages alone
+     */
+    std::vector<std::string> generateSuggestions(const std::vector<CompilerError>& errors,
+                                                const SymbolTable& symbolTable);
+
+    /**
+     * Same, but syntax errors that have a verified repair in 'tokens'
+     * (the token stream that was parsed) get that repair instead
+     */
+    std::vector<std::string> generateSuggestions(const std::vector<CompilerError>& errors,
+                                                const SymbolTable& symbolTable,
+                                                const std::vector<Token>& tokens);
+
+    /**
+     * Walk 'tokens' the way LR1Parser recovers (skip the offending token)
+     * and search a repair at each syntax error. Errors without a repair
+     * that validates within the time budget are left out.
+     */
+    std::vector<Repair> findRepairs(const std::vector<Token>& tokens) const;
+
+    /**
+     * Search time allowed per syntax error
+     */
+    void setTimeBudget(std::chrono::microseconds perError) { budget = perError; }
+
+    // Tokens after a fix that must parse before it is offered
+    static constexpr size_t VALIDATION_WINDOW = 8;
+
+private:
+    LR1Parser parser;   // shares the process-wide parse table
+    std::chrono::microseconds budget{1000};
+
+    bool searchRepair(const ParseState& snapshot, const std::vector<Token>& tokens,
+                      Repair& best) const;
+};
+
+}
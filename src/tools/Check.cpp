@@ -0,0 +1,105 @@
+// scerse_check - headless syntax check of source files.
+//
+// Usage: scerse_check [--stats] <file|->...
+//
+// Each file is memory-mapped read-only and lexed straight from the
+// mapping; the parser pulls tokens one at a time (LR1Parser::validate()
+// on a Lexer), so no copy of the text, no token vector and no AST is
+// made and memory follows parse stack depth rather than file size. Pipes
+// and other unmappable inputs are read into a buffer instead ('-' reads
+// standard input). Diagnostics go to stdout as file:line:column: message;
+// a character no token starts with is reported and skipped like any other
+// syntax error, so the rest of the file is still checked. --stats adds a
+// summary line per file.
+//
+// Exit status: 0 if every file is clean, 1 if any has errors, 2 if any
+// could not be read.
+
+#include "../lexer/Lexer.hpp"
+#include "../parser/LR1Parser.hpp"
+#include "../common/MappedFile.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace SCERSE;
+
+namespace {
+
+const char* severityName(ErrorSeverity severity) {
+    switch (severity) {
+        case ErrorSeverity::WARNING: return "warning";
+        case ErrorSeverity::FATAL:   return "fatal error";
+        case ErrorSeverity::ERROR:
+        default:                     return "error";
+    }
+}
+
+// Returns the number of errors found
+size_t check(const LR1Parser& parser, const char* name, std::string_view source,
+             const char* storage, bool stats) {
+    auto start = std::chrono::steady_clock::now();
+    Lexer lexer(source);
+    ParseResult result = parser.validate(lexer);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    for (const CompilerError& error : result.errors) {
+        std::cout << name << ":" << error.position.line << ":" << error.position.column << ": "
+                  << severityName(error.severity) << ": " << error.message << "\n";
+    }
+    if (stats) {
+        std::printf("%s: %zu bytes (%s), %zu error(s), %.3f ms, %.1f MB/s\n",
+                    name, source.size(), storage, result.errors.size(), ms,
+                    ms > 0.0 ? source.size() / 1e6 / (ms / 1e3) : 0.0);
+    }
+    return result.errors.size();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    bool stats = false;
+    std::vector<const char*> files;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--stats") == 0) {
+            stats = true;
+        } else {
+            files.push_back(argv[i]);
+        }
+    }
+    if (files.empty()) {
+        std::cerr << "Usage: " << argv[0] << " [--stats] <file|->..." << std::endl;
+        return 2;
+    }
+
+    LR1Parser parser;
+    parser.setBackend(ParserBackend::DIRECT);
+
+    bool unreadable = false;
+    size_t errors = 0;
+    for (const char* path : files) {
+        if (std::strcmp(path, "-") == 0) {
+            std::string text((std::istreambuf_iterator<char>(std::cin)), std::istreambuf_iterator<char>());
+            errors += check(parser, "<stdin>", text, "read", stats);
+            continue;
+        }
+
+        MappedFile file;
+        if (!file.open(path)) {
+            std::cerr << "scerse_check: cannot read " << path << std::endl;
+            unreadable = true;
+            continue;
+        }
+        errors += check(parser, path, std::string_view(file.data(), file.size()),
+                        file.isMapped() ? "mapped" : "read", stats);
+    }
+    std::cout.flush();
+
+    if (unreadable) return 2;
+    return errors > 0 ? 1 : 0;
+}
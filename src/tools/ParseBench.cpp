@@ -0,0 +1,283 @@
+// scerse_bench - parser throughput in tokens per second.
+//
+// Usage: scerse_bench [--iterations=N] [--stream] [--validate] [--threads=N] [--direct] [file...]
+//        scerse_bench --lex [--iterations=N] [file...]
+//
+// Each input is lexed once and then parsed N times, so only the parse
+// driver is measured. With --stream every run parses straight from a
+// fresh Lexer, so the time includes lexing. --validate measures
+// LR1Parser::validate() (diagnostics only, no AST) instead of parse().
+// --threads=N parses all inputs together with LR1Parser::parseBatch() on
+// an N-thread pool and reports the combined rate (the synthetic program
+// is repeated 16 times to make a batch). --direct switches the parser to
+// the generated code (ParserBackend::DIRECT) instead of the table
+// lookups; results are compared with a table parse first. Without files
+// a synthetic program is generated.
+//
+// --lex measures Lexer::tokenize() instead, in MB/s, once per scan kernel
+// the CPU supports (see CharScan.hpp); the synthetic input is then ten
+// times larger.
+
+#include "../lexer/Lexer.hpp"
+#include "../lexer/CharScan.hpp"
+#include "../parser/LR1Parser.hpp"
+#include "../common/ThreadPool.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace SCERSE;
+
+namespace {
+
+std::string syntheticSource(int statements) {
+    std::ostringstream out;
+    for (int i = 0; i < statements; ++i) {
+        switch (i % 4) {
+            case 0: out << "var v" << i << " = (v" << i << " + " << i << ") * " << i << " - " << i << " / 2;\n"; break;
+            case 1: out << "int f" << i << "(int a, float b) { var t = a * b + " << i << "; return t; }\n"; break;
+            case 2: out << "const float c" << i << " = " << i << ".5;\n"; break;
+            default: out << "bool b" << i << " = v" << i - 3 << " != " << i << " ;\n"; break;
+        }
+    }
+    return out.str();
+}
+
+bool readFile(const char* path, std::string& text) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    std::ostringstream buffer;
+    buffer << in.rdbuf();
+    text = buffer.str();
+    return true;
+}
+
+const char* backendName(const LR1Parser& parser) {
+    return parser.getBackend() == ParserBackend::DIRECT ? "direct" : "table";
+}
+
+// The backends must agree before their speed is worth comparing
+void checkAgainstTable(const LR1Parser& parser, const std::vector<Token>& tokens, const std::string& name) {
+    LR1Parser reference;   // same shared table, TABLE backend
+    ParseResult expected = reference.parse(tokens);
+    ParseResult actual = parser.parse(tokens);
+    bool same = expected.success == actual.success && expected.errors.size() == actual.errors.size() &&
+                expected.ast.size() == actual.ast.size();
+    for (size_t i = 0; same && i < expected.errors.size(); ++i) {
+        same = expected.errors[i].message == actual.errors[i].message &&
+               expected.errors[i].position.line == actual.errors[i].position.line &&
+               expected.errors[i].position.column == actual.errors[i].position.column;
+    }
+    if (!same) {
+        std::cerr << "Error: " << backendName(parser) << " and table backends disagree on " << name << "\n";
+        std::exit(1);
+    }
+}
+
+void run(const LR1Parser& parser, const std::string& name, const std::string& source,
+         int iterations, bool stream, bool validate) {
+    Lexer lexer(source);
+    std::vector<Token> tokens = lexer.tokenize();
+
+    // One untimed parse so the reusable stacks reach their final size
+    ParseResult warmup = parser.parse(tokens);
+    if (parser.getBackend() != ParserBackend::TABLE) checkAgainstTable(parser, tokens, name);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        ParseResult result;
+        if (stream) {
+            Lexer streamLexer(source);
+            result = validate ? parser.validate(streamLexer) : parser.parse(streamLexer);
+        } else {
+            result = validate ? parser.validate(tokens) : parser.parse(tokens);
+        }
+        if (result.errors.size() != warmup.errors.size()) {
+            std::cerr << "Error: nondeterministic parse of " << name << "\n";
+            std::exit(1);
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double total = static_cast<double>(tokens.size()) * iterations;
+    char line[256];
+    std::snprintf(line, sizeof(line), "%-24s %-6s %9zu tokens %6d runs %9.3f ms %12.0f tokens/s%s\n",
+                  name.c_str(), backendName(parser), tokens.size(), iterations, seconds * 1000.0,
+                  seconds > 0 ? total / seconds : 0.0, warmup.success ? "" : "  (with errors)");
+    std::cout << line;
+}
+
+bool sameTokens(const std::vector<Token>& a, const std::vector<Token>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].type != b[i].type || a[i].lexeme != b[i].lexeme ||
+            a[i].position.line != b[i].position.line || a[i].position.column != b[i].position.column) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void runLexer(const std::string& name, const std::string& source, int iterations) {
+    std::vector<Token> reference;
+    for (ScanKernel kernel : {ScanKernel::SCALAR, ScanKernel::SSE2, ScanKernel::AVX2}) {
+        if (!setScanKernel(kernel)) continue;
+
+        // Also the warmup: every kernel must produce the scalar tokens
+        std::vector<Token> tokens = Lexer(source).tokenize();
+        if (reference.empty()) {
+            reference = std::move(tokens);
+        } else if (!sameTokens(reference, tokens)) {
+            std::cerr << "Error: " << to_cstring(kernel) << " and scalar lexing differ on " << name << "\n";
+            std::exit(1);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        size_t count = 0;
+        for (int i = 0; i < iterations; ++i) {
+            Lexer lexer(source);
+            count += lexer.tokenize().size();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (count != reference.size() * static_cast<size_t>(iterations)) {
+            std::cerr << "Error: nondeterministic lexing of " << name << "\n";
+            std::exit(1);
+        }
+
+        double bytes = static_cast<double>(source.size()) * iterations;
+        char line[256];
+        std::snprintf(line, sizeof(line), "%-24s %-6s %10zu bytes %6d runs %9.3f ms %9.1f MB/s %12.0f tokens/s\n",
+                      name.c_str(), to_cstring(kernel), source.size(), iterations, seconds * 1000.0,
+                      seconds > 0 ? bytes / seconds / 1e6 : 0.0,
+                      seconds > 0 ? static_cast<double>(count) / seconds : 0.0);
+        std::cout << line;
+    }
+    setScanKernel(bestScanKernel());
+}
+
+void runBatch(const LR1Parser& parser, const std::vector<std::string>& sources,
+              int iterations, bool stream, unsigned threads) {
+    std::vector<std::vector<Token>> tokenStreams;
+    size_t tokenCount = 0;
+    for (const std::string& source : sources) {
+        Lexer lexer(source);
+        tokenStreams.push_back(lexer.tokenize());
+        tokenCount += tokenStreams.back().size();
+    }
+
+    ThreadPool pool(threads);
+    std::vector<ParseResult> warmup = parser.parseBatch(tokenStreams, pool);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        std::vector<ParseResult> results = stream ? parser.parseBatch(sources, pool)
+                                                  : parser.parseBatch(tokenStreams, pool);
+        for (size_t j = 0; j < results.size(); ++j) {
+            if (results[j].errors.size() != warmup[j].errors.size()) {
+                std::cerr << "Error: nondeterministic batch parse of input " << j << "\n";
+                std::exit(1);
+            }
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double total = static_cast<double>(tokenCount) * iterations;
+    char line[256];
+    std::snprintf(line, sizeof(line), "batch(%zu inputs, %u threads) %-6s %9zu tokens %6d runs %9.3f ms %12.0f tokens/s\n",
+                  sources.size(), pool.size(), backendName(parser), tokenCount, iterations, seconds * 1000.0,
+                  seconds > 0 ? total / seconds : 0.0);
+    std::cout << line;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int iterations = 200;
+    bool stream = false;
+    bool validate = false;
+    unsigned threads = 0;
+    bool batch = false;
+    bool direct = false;
+    bool lex = false;
+    std::vector<const char*> files;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], "--iterations=", 13) == 0) {
+            iterations = std::atoi(argv[i] + 13);
+            if (iterations <= 0) {
+                std::cerr << "Error: invalid iteration count '" << (argv[i] + 13) << "'\n";
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--stream") == 0) {
+            stream = true;
+        } else if (std::strcmp(argv[i], "--validate") == 0) {
+            validate = true;
+        } else if (std::strcmp(argv[i], "--direct") == 0) {
+            direct = true;
+        } else if (std::strcmp(argv[i], "--lex") == 0) {
+            lex = true;
+        } else if (std::strncmp(argv[i], "--threads=", 10) == 0) {
+            int count = std::atoi(argv[i] + 10);
+            if (count <= 0) {
+                std::cerr << "Error: invalid thread count '" << (argv[i] + 10) << "'\n";
+                return 1;
+            }
+            threads = static_cast<unsigned>(count);
+            batch = true;
+        } else {
+            files.push_back(argv[i]);
+        }
+    }
+
+    if (lex) {
+        if (files.empty()) runLexer("synthetic(40000)", syntheticSource(40000), iterations);
+        for (const char* path : files) {
+            std::string source;
+            if (!readFile(path, source)) {
+                std::cerr << "Error: cannot open " << path << "\n";
+                return 1;
+            }
+            runLexer(path, source, iterations);
+        }
+        return 0;
+    }
+
+    LR1Parser parser;
+    if (direct && !parser.setBackend(ParserBackend::DIRECT)) {
+        std::cerr << "Error: no generated parser for this table (see scerse_tablegen --parser)\n";
+        return 1;
+    }
+
+    if (batch) {
+        std::vector<std::string> sources;
+        if (files.empty()) sources.assign(16, syntheticSource(4000));
+        for (const char* path : files) {
+            std::string source;
+            if (!readFile(path, source)) {
+                std::cerr << "Error: cannot open " << path << "\n";
+                return 1;
+            }
+            sources.push_back(std::move(source));
+        }
+        runBatch(parser, sources, iterations, stream, threads);
+        return 0;
+    }
+
+    if (files.empty()) {
+        run(parser, "synthetic(4000)", syntheticSource(4000), iterations, stream, validate);
+        return 0;
+    }
+
+    for (const char* path : files) {
+        std::string source;
+        if (!readFile(path, source)) {
+            std::cerr << "Error: cannot open " << path << "\n";
+            return 1;
+        }
+        run(parser, path, source, iterations, stream, validate);
+    }
+    return 0;
+}
@@ -0,0 +1,410 @@
+// scerse_tablegen - runs the LR(1) construction at build time and writes the
+// tables as constexpr arrays, so SCERSE never builds them at runtime.
+//
+// Usage: scerse_tablegen [--mode=lr1|lalr|minimal] [--threads=N] [--parser=<file>] <output-header>
+//        scerse_tablegen --report
+//
+// --report builds the tables in every mode and prints state counts and
+// conflicts side by side; the default mode matches ParseTable::defaultMode().
+// --parser also writes the same automaton as directly executable code
+// (the DIRECT backend of LR1Parser).
+
+#include "../parser/ParseTable.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace SCERSE;
+
+namespace {
+
+template <typename T>
+void writeArray(std::ostream& out, const char* type, const char* name,
+                const T* values, size_t count) {
+    out << "constexpr " << type << " " << name << "[] = {";
+    for (size_t i = 0; i < count; ++i) {
+        out << (i % 16 == 0 ? "\n    " : " ") << values[i] << ",";
+    }
+    // Zero-length arrays are not valid C++; an unused 0 keeps the shape legal
+    if (count == 0) out << "\n    0,";
+    out << "\n};\n\n";
+}
+
+// Writes the array if the table has it; returns the initializer to use
+template <typename T>
+std::string writeOptional(std::ostream& out, const char* type, const char* name,
+                          const T* values, size_t count) {
+    if (!values) return "nullptr";
+    writeArray(out, type, name, values, count);
+    return name;
+}
+
+bool parseMode(const std::string& name, TableMode& mode) {
+    if (name == "lr1")     { mode = TableMode::CANONICAL_LR1; return true; }
+    if (name == "lalr")    { mode = TableMode::LALR1;         return true; }
+    if (name == "minimal") { mode = TableMode::MINIMAL_LR1;   return true; }
+    return false;
+}
+
+int printReport() {
+    const TableMode modes[] = {TableMode::CANONICAL_LR1, TableMode::LALR1, TableMode::MINIMAL_LR1};
+    TableBuildReport reports[3];
+    size_t bytes[3];
+    const char* encodings[3];
+    for (int i = 0; i < 3; ++i) {
+        auto table = ParseTable::build(modes[i], &reports[i]);
+        bytes[i] = table->getTableBytes();
+        encodings[i] = table->getEncoding() == TableEncoding::COMB16 ? "comb16"
+                     : table->getEncoding() == TableEncoding::DENSE16 ? "dense16" : "dense32";
+    }
+
+    const TableBuildReport& canonical = reports[0];
+    std::cout << "mode            states  merged  S/R  R/R  new R/R  encoding  ACTION+GOTO bytes\n";
+    for (int i = 0; i < 3; ++i) {
+        const TableBuildReport& r = reports[i];
+        // Merging can only add reduce/reduce conflicts; shift/reduce ones
+        // are inherited unchanged from the canonical collection
+        size_t rr = r.countConflicts(true);
+        size_t added = rr > canonical.countConflicts(true) ? rr - canonical.countConflicts(true) : 0;
+        char line[128];
+        std::snprintf(line, sizeof(line), "%-14s %7zu %7zu %4zu %4zu %8zu  %-8s %17zu\n",
+                      to_cstring(r.mode), r.stateCount, r.mergedStates,
+                      r.countConflicts(false), rr, added, encodings[i], bytes[i]);
+        std::cout << line;
+    }
+    return 0;
+}
+
+
+// Largest group; its members become the switch's default case
+template <typename Key>
+Key largestGroup(const std::map<Key, std::vector<int>>& groups) {
+    auto best = groups.begin();
+    for (auto it = groups.begin(); it != groups.end(); ++it) {
+        if (it->second.size() > best->second.size()) best = it;
+    }
+    return best->first;
+}
+
+// Case labels, eight to a line; 'names' (if given) comments each line
+void writeCases(std::ostream& out, const std::vector<int>& values, const char* indent,
+                std::string (*names)(int) = nullptr) {
+    std::string comment;
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (i % 8 == 0) {
+            if (i > 0) out << comment << "\n";
+            out << indent;
+            comment = names ? "  //" : "";
+        } else {
+            out << " ";
+        }
+        out << "case " << values[i] << ":";
+        if (names) comment += " " + names(values[i]);
+    }
+    out << comment << "\n";
+}
+
+std::string tokenName(int type) {
+    return tokenTypeToString(static_cast<TokenType>(type));
+}
+
+// The automaton as code: one label per state that switches on the
+// lookahead's TokenType. A shift jumps straight to the next state's
+// label; a reduction jumps to its nonterminal's goto block, which picks
+// the target from the state the reduction uncovered - through a label
+// table where the compiler has computed goto, through a switch elsewhere.
+// Every cell comes from the ParseTable (defaults included), so both
+// backends take the same actions on any input.
+bool writeParser(const std::string& path, const ParseTable& table) {
+    const ParseTableData& data = table.getData();
+    const Grammar& grammar = table.getGrammar();
+    const int stateCount = static_cast<int>(data.stateCount);
+    const int nonTerminalCount = static_cast<int>(data.nonTerminalCount);
+
+    // Labels are only written where something jumps to them
+    std::vector<bool> pushed(stateCount, false);         // push_N: d.push(N), then state_N
+    std::vector<bool> entered(stateCount, false);        // state_N itself
+    std::vector<bool> reduced(nonTerminalCount, false);  // goto_N
+    bool gotoErrors = false;
+    entered[0] = true;
+
+    std::vector<std::string> nonTerminalNames(nonTerminalCount);
+    for (const Production& production : grammar.getProductions()) {
+        nonTerminalNames[production.lhs.id] = grammar.getName(production.lhs);
+    }
+
+    std::vector<std::string> stateCode(stateCount);
+    for (int state = 0; state < stateCount; ++state) {
+        // Token types by ACTION cell; types the grammar lacks are errors
+        std::map<int32_t, std::vector<int>> groups;
+        for (int type = 0; type < static_cast<int>(data.tokenTypeCount); ++type) {
+            int terminal = data.terminalMap[type];
+            groups[terminal >= 0 ? table.actionCell(state, terminal) : 0].push_back(type);
+        }
+        const int32_t fallback = largestGroup(groups);
+
+        std::ostringstream code;
+        auto writeAction = [&](int32_t cell) {
+            Action action = ParseTable::decodeAction(cell);
+            switch (action.type) {
+                case ActionType::SHIFT:
+                    pushed[action.value] = true;
+                    code << "            d.shift(); goto push_" << action.value << ";\n";
+                    break;
+                case ActionType::REDUCE: {
+                    const ProductionInfo& info = data.productions[action.value];
+                    reduced[info.lhs] = true;
+                    code << "            state = d.reduce(" << action.value << ", " << info.rhsLength
+                         << "); goto goto_" << info.lhs << ";\n";
+                    break;
+                }
+                case ActionType::ACCEPT:
+                    code << "            d.accept(); return;\n";
+                    break;
+                case ActionType::ERROR:
+                default:
+                    entered[state] = true;
+                    code << "            if (d.error()) goto state_" << state << ";\n"
+                         << "            return;\n";
+                    break;
+            }
+        };
+        code << "    switch (d.lookahead()) {\n";
+        for (const auto& group : groups) {
+            if (group.first == fallback) continue;
+            writeCases(code, group.second, "        ", tokenName);
+            writeAction(group.first);
+        }
+        code << "        default:\n";
+        writeAction(fallback);
+        code << "    }\n\n";
+        stateCode[state] = code.str();
+    }
+
+    // GOTO cells of every state, for each nonterminal a reduction produces
+    std::ostringstream gotos;
+    std::ostringstream labelTables;
+    for (int nt = 0; nt < nonTerminalCount; ++nt) {
+        if (!reduced[nt]) continue;
+        std::map<int, std::vector<int>> groups;
+        for (int state = 0; state < stateCount; ++state) {
+            int target = table.getGoto(state, nt);
+            groups[target].push_back(state);
+            if (target >= 0) pushed[target] = true; else gotoErrors = true;
+        }
+        auto jump = [](int target) {
+            return target >= 0 ? "push_" + std::to_string(target) : std::string("goto_error");
+        };
+
+        gotos << "goto_" << nt << ":  // " << nonTerminalNames[nt] << "\n";
+        if (groups.size() == 1) {
+            gotos << "    goto " << jump(groups.begin()->first) << ";\n\n";
+            continue;
+        }
+
+        labelTables << "    static void* const GOTO_" << nt << "[] = {";
+        for (int state = 0; state < stateCount; ++state) {
+            labelTables << (state % 8 == 0 ? "\n        " : " ") << "&&" << jump(table.getGoto(state, nt)) << ",";
+        }
+        labelTables << "\n    };\n";
+
+        const int fallback = largestGroup(groups);
+        gotos << "#ifdef SCERSE_COMPUTED_GOTO\n"
+              << "    goto *GOTO_" << nt << "[state];\n"
+              << "#else\n"
+              << "    switch (state) {\n";
+        for (const auto& group : groups) {
+            if (group.first == fallback) continue;
+            writeCases(gotos, group.second, "        ");
+            gotos << "            goto " << jump(group.first) << ";\n";
+        }
+        gotos << "        default:\n"
+              << "            goto " << jump(fallback) << ";\n"
+              << "    }\n"
+              << "#endif\n\n";
+    }
+    // A missing GOTO entry continues in the uncovered state
+    if (gotoErrors) entered.assign(stateCount, true);
+
+    std::ostringstream out;
+    out << "// Generated by scerse_tablegen from src/parser/Grammar.cpp - do not edit.\n"
+        << "#pragma once\n\n"
+        << "#include <cstdint>\n\n"
+        << "#if defined(__GNUC__) || defined(__clang__)\n"
+        << "#define SCERSE_COMPUTED_GOTO\n"
+        << "#endif\n\n"
+        << "namespace SCERSE {\n"
+        << "namespace GeneratedParser {\n\n"
+        << "// The ParseTable this code was generated from\n"
+        << "constexpr uint64_t GRAMMAR_HASH = " << data.grammarHash << "ULL;\n"
+        << "constexpr uint32_t MODE = " << data.mode << ";  // " << to_cstring(table.getMode()) << "\n"
+        << "constexpr uint32_t ENCODING = " << data.encoding << ";\n"
+        << "constexpr uint32_t STATE_COUNT = " << data.stateCount << ";\n\n"
+        << "// Runs the automaton from state 0, which the driver has already pushed.\n"
+        << "// Cases are TokenType values. The driver provides:\n"
+        << "//   int lookahead()          TokenType of the current token\n"
+        << "//   void push(int state)\n"
+        << "//   void shift()             push the current token and advance\n"
+        << "//   int reduce(int production, int rhsLength)\n"
+        << "//                            replace the RHS by its value; returns the uncovered state\n"
+        << "//   bool error()             report and skip the token; false ends the parse\n"
+        << "//   bool gotoError()         the same for a missing GOTO entry\n"
+        << "//   void accept()\n"
+        << "template <typename Driver>\n"
+        << "void run(Driver& d) {\n"
+        << "    int state = 0;\n"
+        << "#ifdef SCERSE_COMPUTED_GOTO\n";
+    if (gotoErrors) {
+        out << "    static void* const STATES[] = {";
+        for (int state = 0; state < stateCount; ++state) {
+            out << (state % 8 == 0 ? "\n        " : " ") << "&&state_" << state << ",";
+        }
+        out << "\n    };\n";
+    }
+    out << labelTables.str()
+        << "#endif\n"
+        << "    goto state_0;\n\n";
+
+    for (int state = 0; state < stateCount; ++state) {
+        if (pushed[state]) out << "push_" << state << ":\n    d.push(" << state << ");\n";
+        if (entered[state]) out << "state_" << state << ":\n";
+        out << stateCode[state];
+    }
+    out << gotos.str();
+
+    if (gotoErrors) {
+        out << "goto_error:\n"
+            << "    if (!d.gotoError()) return;\n"
+            << "#ifdef SCERSE_COMPUTED_GOTO\n"
+            << "    goto *STATES[state];\n"
+            << "#else\n"
+            << "    switch (state) {\n";
+        for (int state = 0; state < stateCount; ++state) {
+            out << "        case " << state << ": goto state_" << state << ";\n";
+        }
+        out << "        default: return;\n"
+            << "    }\n"
+            << "#endif\n";
+    }
+    out << "}\n\n"
+        << "} // namespace GeneratedParser\n"
+        << "} // namespace SCERSE\n";
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "scerse_tablegen: cannot write " << path << std::endl;
+        return false;
+    }
+    file << out.str();
+    return static_cast<bool>(file);
+}
+
+int usage(const char* program) {
+    std::cerr << "Usage: " << program << " [--mode=lr1|lalr|minimal] [--threads=N] [--parser=<file>] <output-header>\n"
+              << "       " << program << " --report" << std::endl;
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    TableMode mode = ParseTable::defaultMode();
+    unsigned threads = 0;
+    std::string outputPath;
+    std::string parserPath;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--report") == 0) {
+            return printReport();
+        }
+        if (std::strncmp(argv[i], "--mode=", 7) == 0) {
+            if (!parseMode(argv[i] + 7, mode)) {
+                std::cerr << "scerse_tablegen: unknown mode " << (argv[i] + 7) << std::endl;
+                return 2;
+            }
+        } else if (std::strncmp(argv[i], "--threads=", 10) == 0) {
+            char* end = nullptr;
+            threads = static_cast<unsigned>(std::strtoul(argv[i] + 10, &end, 10));
+            if (end == argv[i] + 10 || *end != '\0') {
+                std::cerr << "scerse_tablegen: bad thread count " << (argv[i] + 10) << std::endl;
+                return 2;
+            }
+        } else if (std::strncmp(argv[i], "--parser=", 9) == 0) {
+            parserPath = argv[i] + 9;
+        } else if (argv[i][0] == '-') {
+            // A misspelt option must not become the output path
+            std::cerr << "scerse_tablegen: unknown option " << argv[i] << std::endl;
+            return usage(argv[0]);
+        } else if (!outputPath.empty()) {
+            std::cerr << "scerse_tablegen: more than one output header given" << std::endl;
+            return usage(argv[0]);
+        } else {
+            outputPath = argv[i];
+        }
+    }
+    if (outputPath.empty()) return usage(argv[0]);
+
+    auto table = ParseTable::build(mode, nullptr, threads);
+    const ParseTableData& data = table->getData();
+    if (data.stateCount == 0) {
+        std::cerr << "scerse_tablegen: LR(1) construction produced no states" << std::endl;
+        return 1;
+    }
+    if (!parserPath.empty() && !writeParser(parserPath, *table)) return 1;
+
+    std::ostringstream out;
+    out << "// Generated by scerse_tablegen from src/parser/Grammar.cpp - do not edit.\n"
+        << "#pragma once\n\n"
+        << "#include \"parser/ParseTable.hpp\"\n\n"
+        << "namespace SCERSE {\n"
+        << "namespace GeneratedTables {\n\n";
+
+    const size_t actionCells = static_cast<size_t>(data.stateCount) * data.terminalCount;
+    const size_t gotoCells = static_cast<size_t>(data.stateCount) * data.nonTerminalCount;
+    const std::string cells[] = {
+        writeOptional(out, "int32_t", "ACTIONS", data.actions, actionCells),
+        writeOptional(out, "int32_t", "GOTOS", data.gotos, gotoCells),
+        writeOptional(out, "int16_t", "ACTIONS16", data.actions16, actionCells),
+        writeOptional(out, "int16_t", "GOTOS16", data.gotos16, gotoCells),
+        writeOptional(out, "int32_t", "COMB_BASE", data.combBase, data.stateCount),
+        writeOptional(out, "int16_t", "COMB_CHECK", data.combCheck, data.combSize),
+        writeOptional(out, "int16_t", "COMB_VALUE", data.combValue, data.combSize),
+        writeOptional(out, "int16_t", "ACTION_DEFAULT", data.actionDefault, data.stateCount),
+        writeOptional(out, "int16_t", "GOTO_DEFAULT", data.gotoDefault, data.nonTerminalCount),
+    };
+    writeArray(out, "int32_t", "TERMINAL_MAP", data.terminalMap, data.tokenTypeCount);
+
+    out << "constexpr ProductionInfo PRODUCTIONS[] = {\n";
+    for (uint32_t i = 0; i < data.productionCount; ++i) {
+        const ProductionInfo& p = data.productions[i];
+        out << "    {" << p.lhs << ", " << p.rhsLength << ", " << p.nodeKind << "},"
+            << "  // " << i << ": " << table->getGrammar().getName(table->getGrammar().getProduction(i).lhs) << "\n";
+    }
+    out << "};\n\n";
+
+    out << "constexpr ParseTableData PARSE_TABLE = {\n"
+        << "    " << data.grammarHash << "ULL,  // Grammar::getContentHash()\n"
+        << "    " << data.stateCount << ", " << data.terminalCount << ", "
+        << data.nonTerminalCount << ", " << data.productionCount << ", "
+        << data.tokenTypeCount << ",\n"
+        << "    " << data.mode << ", " << data.encoding << ", " << data.combSize << ",  // "
+        << to_cstring(mode) << ", encoding, comb size\n"
+        << "    PRODUCTIONS, TERMINAL_MAP,\n"
+        << "    " << cells[0] << ", " << cells[1] << ", " << cells[2] << ", " << cells[3] << ",\n"
+        << "    " << cells[4] << ", " << cells[5] << ", " << cells[6] << ", " << cells[7] << ", " << cells[8] << "\n"
+        << "};\n\n"
+        << "} // namespace GeneratedTables\n"
+        << "} // namespace SCERSE\n";
+
+    std::ofstream file(outputPath, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "scerse_tablegen: cannot write " << outputPath << std::endl;
+        return 1;
+    }
+    file << out.str();
+    return file ? 0 : 1;
+}
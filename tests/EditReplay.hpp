@@ -0,0 +1,100 @@
+#pragma once
+
+// Deterministic random edits for the incremental lexing/parsing tests.
+// Every edit is replayed against a fresh Lexer (and LR1Parser), so these
+// only need to produce awkward edits, not check anything themselves.
+// describe() prints tokens and parse results for comparison.
+
+#include "lexer/Token.hpp"
+#include "lexer/TokenBuffer.hpp"
+#include "common/AST.hpp"
+#include "parser/LR1Parser.hpp"
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace SCERSE {
+namespace test {
+
+inline const std::vector<std::string>& seedDocuments() {
+    static const std::vector<std::string> documents = {
+        "int add(int a, int b) {\n"
+        "    return a + b;\n"
+        "}\n"
+        "var total = add(1, 2) * 3;\n"
+        "if (total >= 9) {\n"
+        "    total = total - 1;\n"
+        "} else {\n"
+        "    total = 0;\n"
+        "}\n",
+
+        "// leading comment\n"
+        "string name = \"scerse\"; // trailing comment\n"
+        "float ratio = 2.5 / 4;\n"
+        "bool done = false;\n"
+        "while (ratio < 10.0) { ratio = ratio * 2; }\n"
+        "const int limit = 100;\n",
+
+        "var a = 1;\n"
+        "var b = (a + 2;\n"
+        "int f(int x) { return x % 3; }\n"
+        "@ var c = a != b;\n"
+        "\n"
+        "\n"
+        "void g() { var d = !c; }\n",
+    };
+    return documents;
+}
+
+/**
+ * Random edit of 'text': anywhere in it, removing up to 8 bytes and/or
+ * inserting a snippet that can open or close a statement, a string or a
+ * comment, or add lines
+ */
+inline TextEdit randomEdit(std::mt19937& rng, const std::string& text) {
+    static const char* const snippets[] = {
+        "x", "1", "+", " ", ";", "\n", "\n\n", "int ", "var a = 1;\n", "{", "}", "(", ")",
+        "=", "==", "@", "float f(int a) { return a; }\n", "return", "2.5", ",", "q = ", "b3",
+        "//", "/", "\"", "\"s\" ", "[", "]", "// c\n", "&", "|",
+    };
+    const size_t snippetCount = sizeof(snippets) / sizeof(snippets[0]);
+
+    TextEdit edit;
+    edit.offset = rng() % (text.size() + 1);
+    const size_t maxRemoved = std::min<size_t>(text.size() - edit.offset, 8);
+    edit.removed = rng() % 3 == 0 ? 0 : rng() % (maxRemoved + 1);
+    if (rng() % 4 != 0) edit.inserted = snippets[rng() % snippetCount];
+    return edit;
+}
+
+inline std::string describe(const std::vector<Token>& tokens) {
+    std::ostringstream out;
+    for (const Token& token : tokens) {
+        out << tokenTypeToString(token.type) << " '" << token.lexeme << "' "
+            << token.position.line << ":" << token.position.column << "\n";
+    }
+    return out.str();
+}
+
+inline void describe(std::ostream& out, const ASTArena& ast, NodeId id, int depth) {
+    if (id == NO_NODE) return;
+    const ASTNode& node = ast[id];
+    out << std::string(depth * 2, ' ') << static_cast<int>(node.type) << " '" << node.value << "' "
+        << node.position.line << ":" << node.position.column << "\n";
+    for (NodeId child : ast.children(id)) describe(out, ast, child, depth + 1);
+}
+
+inline std::string describe(const ParseResult& result) {
+    std::ostringstream out;
+    out << "success=" << result.success << "\n";
+    for (const CompilerError& error : result.errors) {
+        out << error.position.line << ":" << error.position.column << " " << error.message << "\n";
+    }
+    if (result.ast) describe(out, result.ast, result.ast.root(), 0);
+    return out.str();
+}
+
+} // namespace test
+} // namespace SCERSE
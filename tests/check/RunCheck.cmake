@@ -0,0 +1,21 @@
+# Runs scerse_check (CHECK) on INPUT, a file in this directory, and
+# compares its diagnostics with INPUT's .expected file and its exit status
+# with EXPECTED_STATUS.
+#
+# cmake -DCHECK=<scerse_check> -DINPUT=<file.scr> -DEXPECTED_STATUS=<n> -P RunCheck.cmake
+
+execute_process(COMMAND ${CHECK} ${INPUT}
+                WORKING_DIRECTORY ${CMAKE_CURRENT_LIST_DIR}
+                OUTPUT_VARIABLE output
+                RESULT_VARIABLE status)
+
+get_filename_component(name ${INPUT} NAME_WE)
+file(READ ${CMAKE_CURRENT_LIST_DIR}/${name}.expected expected)
+string(REPLACE "\r" "" expected "${expected}")
+
+if(NOT output STREQUAL expected)
+    message(FATAL_ERROR "scerse_check ${INPUT} printed:\n${output}\nexpected:\n${expected}")
+endif()
+if(NOT status EQUAL EXPECTED_STATUS)
+    message(FATAL_ERROR "scerse_check ${INPUT} exited with ${status}, expected ${EXPECTED_STATUS}")
+endif()
@@ -0,0 +1,87 @@
+// IncrementalParser must always agree with a full parse of its text:
+// LR1Parser::parse(Lexer(text).tokenize()). Replays a fixed series of
+// random edits and compares after every one.
+
+#include "EditReplay.hpp"
+#include "lexer/Lexer.hpp"
+#include "parser/IncrementalParser.hpp"
+#include "parser/LR1Parser.hpp"
+#include <gtest/gtest.h>
+
+using namespace SCERSE;
+using namespace SCERSE::test;
+
+namespace {
+
+// Mixes applyEdit() with update(), which has to find the edit itself
+void replay(unsigned seed, int edits) {
+    std::mt19937 rng(seed);
+    LR1Parser full;
+    for (const std::string& document : seedDocuments()) {
+        std::string text = document;
+        IncrementalParser incremental;
+        incremental.reset(text);
+
+        for (int i = 0; i < edits; ++i) {
+            const TextEdit edit = randomEdit(rng, text);
+            text.replace(edit.offset, edit.removed, edit.inserted);
+            const ParseResult& result = rng() % 5 == 0 ? incremental.update(text) : incremental.applyEdit(edit);
+
+            const std::vector<Token> tokens = Lexer(text).tokenize();
+            const ParseResult expected = full.parse(tokens);
+            SCOPED_TRACE("seed " + std::to_string(seed) + ", edit " + std::to_string(i) + ":\n" + text);
+            ASSERT_EQ(incremental.getText(), text);
+            ASSERT_EQ(test::describe(incremental.getTokens()), test::describe(tokens));
+            ASSERT_EQ(describe(result), describe(expected));
+        }
+    }
+}
+
+} // namespace
+
+TEST(IncrementalParser, MatchesFullParseAfterEveryEdit) {
+    for (unsigned seed = 1; seed <= 4; ++seed) replay(seed, 600);
+}
+
+TEST(IncrementalParser, ResetMatchesFullParse) {
+    LR1Parser full;
+    for (const std::string& document : seedDocuments()) {
+        IncrementalParser incremental;
+        const ParseResult& result = incremental.reset(document);
+        const std::vector<Token> tokens = Lexer(document).tokenize();
+        EXPECT_EQ(describe(result), describe(full.parse(tokens)));
+        EXPECT_TRUE(incremental.getLastUpdate().fullParse);
+    }
+}
+
+TEST(IncrementalParser, EditInsideOneStatementReusesTheRest) {
+    std::string text;
+    for (int i = 0; i < 200; ++i) text += "var v" + std::to_string(i) + " = " + std::to_string(i) + ";\n";
+    IncrementalParser incremental;
+    incremental.reset(text);
+    const size_t fullActions = incremental.getLastUpdate().parserActions;
+
+    TextEdit edit;
+    edit.offset = text.find("= 100;") + 2;
+    edit.removed = 3;
+    edit.inserted = "7 + 8";
+    const ParseResult& result = incremental.applyEdit(edit);
+    text.replace(edit.offset, edit.removed, edit.inserted);
+
+    EXPECT_TRUE(result.success);
+    EXPECT_FALSE(incremental.getLastUpdate().fullParse);
+    // Only the edited statement and the list reductions at EOF are redone
+    EXPECT_LT(incremental.getLastUpdate().parserActions, fullActions / 4);
+    EXPECT_EQ(describe(result), describe(LR1Parser().parse(Lexer(text).tokenize())));
+}
+
+TEST(IncrementalParser, UpdateThatOnlyMovesLines) {
+    // Deleting a leading comment replaces no token but moves every one
+    std::string text = "// header\n\nvar a = 1;\nvar b = ;\n";
+    IncrementalParser incremental;
+    incremental.reset(text);
+    text.erase(0, text.find('\n') + 1);
+    const ParseResult& result = incremental.update(text);
+    EXPECT_EQ(describe(result), describe(LR1Parser().parse(Lexer(text).tokenize())));
+    EXPECT_EQ(test::describe(incremental.getTokens()), test::describe(Lexer(text).tokenize()));
+}
@@ -0,0 +1,125 @@
+// LR1Parser entry points that must agree with each other: parseBatch()
+// against one parse at a time, and the generated DIRECT parser and the
+// embedded tables against table lookups in a freshly built table.
+
+#include "EditReplay.hpp"
+#include "common/ThreadPool.hpp"
+#include "lexer/Lexer.hpp"
+#include "parser/LR1Parser.hpp"
+#include "parser/ParseTable.hpp"
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace SCERSE;
+using namespace SCERSE::test;
+
+namespace {
+
+std::vector<std::string> batchSources() {
+    std::vector<std::string> sources = seedDocuments();
+    sources.push_back("@ var w = 4;\n");
+    sources.push_back("var x = 1;\nvar y = 2 $ 3;\nvar z = ;\n");
+    sources.push_back("");
+    return sources;
+}
+
+// Clean documents, the same after random edits, and inputs that run into
+// MAX_ERRORS in the middle of a statement and at its end
+std::vector<std::string> backendSources() {
+    std::vector<std::string> sources = batchSources();
+    std::mt19937 rng(19);
+    for (const std::string& document : seedDocuments()) {
+        std::string text = document;
+        for (int i = 0; i < 100; ++i) {
+            const TextEdit edit = randomEdit(rng, text);
+            text.replace(edit.offset, edit.removed, edit.inserted);
+            sources.push_back(text);
+        }
+    }
+    sources.push_back(std::string(120, '@'));
+    for (int count : {LR1Parser::MAX_ERRORS - 1, LR1Parser::MAX_ERRORS, LR1Parser::MAX_ERRORS + 1}) {
+        std::string text;
+        for (int i = 0; i < count; ++i) text += "var x = ;\n";
+        sources.push_back(text);
+        sources.push_back(text + "int f( { return 1; }\n");
+    }
+    std::string unbalanced;
+    for (int i = 0; i < 40; ++i) unbalanced += "if (a) { while (b { x = (1 + ; }\n";
+    sources.push_back(unbalanced);
+    return sources;
+}
+
+// Every entry point of 'actual' must agree with the same one of 'expected'
+void expectSameResults(const LR1Parser& actual, const LR1Parser& expected) {
+    for (const std::string& source : backendSources()) {
+        SCOPED_TRACE(source);
+        const std::vector<Token> tokens = Lexer(source).tokenize();
+        EXPECT_EQ(describe(actual.parse(tokens)), describe(expected.parse(tokens)));
+        EXPECT_EQ(describe(actual.validate(tokens)), describe(expected.validate(tokens)));
+
+        Lexer actualLexer(source), expectedLexer(source);
+        EXPECT_EQ(describe(actual.parse(actualLexer)), describe(expected.parse(expectedLexer)));
+        Lexer actualValidate(source), expectedValidate(source);
+        EXPECT_EQ(describe(actual.validate(actualValidate)), describe(expected.validate(expectedValidate)));
+    }
+}
+
+} // namespace
+
+TEST(LR1Parser, BatchOfSourcesMatchesStreamingParses) {
+    const std::vector<std::string> sources = batchSources();
+    LR1Parser parser;
+    ThreadPool pool(4);
+    const std::vector<ParseResult> results = parser.parseBatch(sources, pool);
+
+    ASSERT_EQ(results.size(), sources.size());
+    for (size_t i = 0; i < sources.size(); ++i) {
+        SCOPED_TRACE(sources[i]);
+        Lexer lexer(sources[i]);
+        EXPECT_EQ(describe(results[i]), describe(parser.parse(lexer)));
+    }
+}
+
+TEST(LR1Parser, BatchGoesOnAfterAnUnknownCharacter) {
+    LR1Parser parser;
+    ThreadPool pool(2);
+    const std::vector<ParseResult> results = parser.parseBatch(std::vector<std::string>{"@ var w = ;\n"}, pool);
+
+    ASSERT_EQ(results.size(), 1u);
+    ASSERT_GE(results[0].errors.size(), 2u);
+    EXPECT_FALSE(results[0].success);
+    EXPECT_EQ(results[0].errors[0].message, "Unexpected character: @");
+    EXPECT_EQ(results[0].errors[1].position.column, 11);
+}
+
+TEST(LR1Parser, BatchOfTokenStreamsMatchesSingleParses) {
+    const std::vector<std::string> sources = batchSources();
+    std::vector<std::vector<Token>> streams;
+    for (const std::string& source : sources) streams.push_back(Lexer(source).tokenize());
+
+    LR1Parser parser;
+    ThreadPool pool(4);
+    const std::vector<ParseResult> results = parser.parseBatch(streams, pool);
+
+    ASSERT_EQ(results.size(), streams.size());
+    for (size_t i = 0; i < streams.size(); ++i) {
+        SCOPED_TRACE(sources[i]);
+        EXPECT_EQ(describe(results[i]), describe(parser.parse(streams[i])));
+    }
+}
+
+TEST(LR1Parser, DirectBackendMatchesTableBackend) {
+    LR1Parser table;
+    LR1Parser direct;
+    ASSERT_TRUE(direct.setBackend(ParserBackend::DIRECT));
+    ASSERT_EQ(table.getBackend(), ParserBackend::TABLE);
+    expectSameResults(direct, table);
+}
+
+TEST(LR1Parser, EmbeddedTablesMatchABuiltTable) {
+    std::shared_ptr<const ParseTable> embedded = ParseTable::embedded();
+    ASSERT_NE(embedded, nullptr);
+    LR1Parser fromEmbedded(embedded);
+    LR1Parser fromBuilt(ParseTable::build());
+    expectSameResults(fromEmbedded, fromBuilt);
+}
@@ -0,0 +1,142 @@
+// The binary table file: a saved table must load back cell for cell, and
+// any file that is damaged, from another format version, grammar or
+// TableMode must be refused (load() returns nullptr) so that
+// loadOrBuild() replaces it.
+
+#include "parser/ParseTable.hpp"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace SCERSE;
+
+namespace {
+
+// Header field offsets (see TableFileHeader in ParseTable.cpp)
+constexpr size_t VERSION_OFFSET = 4;
+constexpr size_t GRAMMAR_HASH_OFFSET = 8;
+constexpr size_t HEADER_SIZE = 56;
+
+std::string tablePath(const std::string& name) {
+    return ::testing::TempDir() + "scerse_" + name + ".tbl";
+}
+
+std::vector<char> readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+void writeFile(const std::string& path, const std::vector<char>& bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+template <typename T>
+void addToField(std::vector<char>& bytes, size_t offset, T delta) {
+    T value;
+    std::memcpy(&value, bytes.data() + offset, sizeof(value));
+    value += delta;
+    std::memcpy(bytes.data() + offset, &value, sizeof(value));
+}
+
+void expectSameCells(const ParseTable& actual, const ParseTable& expected) {
+    ASSERT_EQ(actual.getStateCount(), expected.getStateCount());
+    ASSERT_EQ(actual.getTerminalCount(), expected.getTerminalCount());
+    ASSERT_EQ(actual.getNonTerminalCount(), expected.getNonTerminalCount());
+    EXPECT_EQ(actual.getMode(), expected.getMode());
+    EXPECT_EQ(actual.getEncoding(), expected.getEncoding());
+
+    for (int state = 0; state < static_cast<int>(expected.getStateCount()); ++state) {
+        for (int terminal = 0; terminal < static_cast<int>(expected.getTerminalCount()); ++terminal) {
+            ASSERT_EQ(actual.actionCell(state, terminal), expected.actionCell(state, terminal))
+                << "state " << state << ", terminal " << terminal;
+        }
+        for (int nonTerminal = 0; nonTerminal < static_cast<int>(expected.getNonTerminalCount()); ++nonTerminal) {
+            ASSERT_EQ(actual.getGoto(state, nonTerminal), expected.getGoto(state, nonTerminal))
+                << "state " << state << ", nonterminal " << nonTerminal;
+        }
+    }
+}
+
+class ParseTableFile : public ::testing::Test {
+protected:
+    static void SetUpTestSuite() { built = ParseTable::build(); }
+    static void TearDownTestSuite() { built.reset(); }
+
+    // A good file, changed by 'damage', must not load
+    void expectRefused(const std::string& name, void (*damage)(std::vector<char>&)) {
+        const std::string path = tablePath(name);
+        ASSERT_TRUE(built->save(path));
+        std::vector<char> bytes = readFile(path);
+        ASSERT_GT(bytes.size(), HEADER_SIZE);
+        damage(bytes);
+        writeFile(path, bytes);
+        EXPECT_EQ(ParseTable::load(path), nullptr);
+    }
+
+    static std::shared_ptr<const ParseTable> built;
+};
+
+std::shared_ptr<const ParseTable> ParseTableFile::built;
+
+} // namespace
+
+TEST_F(ParseTableFile, SaveThenLoadGivesTheSameCells) {
+    const std::string path = tablePath("roundtrip");
+    ASSERT_TRUE(built->save(path));
+    std::shared_ptr<const ParseTable> loaded = ParseTable::load(path);
+    ASSERT_NE(loaded, nullptr);
+    EXPECT_TRUE(loaded->isMapped());
+    expectSameCells(*loaded, *built);
+
+    // A mapped table saves the same bytes again
+    const std::string copy = tablePath("roundtrip_copy");
+    ASSERT_TRUE(loaded->save(copy));
+    EXPECT_EQ(readFile(copy), readFile(path));
+}
+
+TEST_F(ParseTableFile, TruncatedFileIsRefused) {
+    expectRefused("truncated", [](std::vector<char>& bytes) { bytes.resize(bytes.size() - 2); });
+    expectRefused("header_only", [](std::vector<char>& bytes) { bytes.resize(HEADER_SIZE); });
+    expectRefused("partial_header", [](std::vector<char>& bytes) { bytes.resize(HEADER_SIZE / 2); });
+}
+
+TEST_F(ParseTableFile, FlippedPayloadByteIsRefused) {
+    expectRefused("flipped_first", [](std::vector<char>& bytes) { bytes[HEADER_SIZE] ^= 0x01; });
+    expectRefused("flipped_last", [](std::vector<char>& bytes) { bytes.back() ^= 0x40; });
+}
+
+TEST_F(ParseTableFile, OtherFileVersionIsRefused) {
+    expectRefused("version", [](std::vector<char>& bytes) { addToField<uint32_t>(bytes, VERSION_OFFSET, 1); });
+}
+
+TEST_F(ParseTableFile, OtherGrammarIsRefused) {
+    expectRefused("grammar", [](std::vector<char>& bytes) { addToField<uint64_t>(bytes, GRAMMAR_HASH_OFFSET, 1); });
+}
+
+TEST_F(ParseTableFile, OtherTableModeIsRefused) {
+    ASSERT_NE(ParseTable::defaultMode(), TableMode::LALR1);
+    const std::string path = tablePath("lalr");
+    ASSERT_TRUE(ParseTable::build(TableMode::LALR1)->save(path));
+    EXPECT_EQ(ParseTable::load(path), nullptr);
+}
+
+TEST_F(ParseTableFile, LoadOrBuildRewritesARefusedFile) {
+    const std::string path = tablePath("rewrite");
+    writeFile(path, std::vector<char>(100, 'x'));
+    ASSERT_EQ(ParseTable::load(path), nullptr);
+
+    std::shared_ptr<const ParseTable> rebuilt = ParseTable::loadOrBuild(path);
+    ASSERT_NE(rebuilt, nullptr);
+    EXPECT_FALSE(rebuilt->isMapped());
+    expectSameCells(*rebuilt, *built);
+
+    std::shared_ptr<const ParseTable> loaded = ParseTable::load(path);
+    ASSERT_NE(loaded, nullptr);
+    EXPECT_TRUE(loaded->isMapped());
+    expectSameCells(*loaded, *built);
+}
@@ -0,0 +1,95 @@
+// TokenBuffer must always hold the tokens of Lexer(getText()).tokenize(),
+// and each TokenDiff must describe exactly what changed. Replays a fixed
+// series of random edits and checks both after every one.
+
+#include "EditReplay.hpp"
+#include "lexer/Lexer.hpp"
+#include "lexer/TokenBuffer.hpp"
+#include <gtest/gtest.h>
+
+using namespace SCERSE;
+using namespace SCERSE::test;
+
+namespace {
+
+// Tokens outside the diff's range are the old ones: the same before it,
+// and after it moved by the token and line deltas
+void expectDiffMatches(const std::vector<Token>& before, const std::vector<Token>& after,
+                       const TokenDiff& diff) {
+    if (diff.full) return;
+    ASSERT_LE(diff.first + diff.removed, before.size());
+    ASSERT_LE(diff.first + diff.inserted, after.size());
+    ASSERT_EQ(before.size() - diff.removed, after.size() - diff.inserted);
+
+    for (size_t i = 0; i < diff.first; ++i) {
+        EXPECT_EQ(after[i].type, before[i].type) << "token " << i;
+        EXPECT_EQ(after[i].position.line, before[i].position.line) << "token " << i;
+        EXPECT_EQ(after[i].position.column, before[i].position.column) << "token " << i;
+    }
+    for (size_t i = diff.first + diff.removed; i < before.size(); ++i) {
+        const Token& old = before[i];
+        const Token& moved = after[i - diff.removed + diff.inserted];
+        const int line = old.position.line > diff.lastEditedLine ? old.position.line + diff.lineDelta
+                                                                  : old.position.line;
+        EXPECT_EQ(moved.type, old.type) << "old token " << i;
+        EXPECT_EQ(moved.position.line, line) << "old token " << i;
+        EXPECT_EQ(moved.position.column, old.position.column) << "old token " << i;
+    }
+}
+
+void replay(unsigned seed, int edits) {
+    std::mt19937 rng(seed);
+    for (const std::string& document : seedDocuments()) {
+        std::string text = document;
+        TokenBuffer buffer;
+        buffer.reset(text);
+
+        for (int i = 0; i < edits; ++i) {
+            const TextEdit edit = randomEdit(rng, text);
+            text.replace(edit.offset, edit.removed, edit.inserted);
+            const std::vector<Token> before = buffer.getTokens();
+            const TokenDiff diff = rng() % 5 == 0 ? buffer.update(text) : buffer.applyEdit(edit);
+
+            SCOPED_TRACE("seed " + std::to_string(seed) + ", edit " + std::to_string(i) + ":\n" + text);
+            ASSERT_EQ(buffer.getText(), text);
+            ASSERT_EQ(test::describe(buffer.getTokens()), test::describe(Lexer(text).tokenize()));
+            expectDiffMatches(before, buffer.getTokens(), diff);
+
+            // Lexemes view the buffer's own text
+            const std::string& own = buffer.getText();
+            for (const Token& token : buffer.getTokens()) {
+                if (token.type == TokenType::EOF_TOKEN) continue;
+                ASSERT_GE(token.lexeme.data(), own.data());
+                ASSERT_LE(token.lexeme.data() + token.lexeme.size(), own.data() + own.size());
+            }
+        }
+    }
+}
+
+} // namespace
+
+TEST(TokenBuffer, MatchesFreshLexAfterEveryEdit) {
+    for (unsigned seed = 1; seed <= 4; ++seed) replay(seed, 800);
+}
+
+TEST(TokenBuffer, UpdateWithSameTextChangesNothing) {
+    TokenBuffer buffer;
+    buffer.reset(seedDocuments()[0]);
+    EXPECT_TRUE(buffer.update(seedDocuments()[0]).unchanged());
+}
+
+TEST(TokenBuffer, EditRelexesOnlyItsLine) {
+    std::string text;
+    for (int i = 0; i < 100; ++i) text += "var v" + std::to_string(i) + " = " + std::to_string(i) + ";\n";
+    TokenBuffer buffer;
+    buffer.reset(text);
+
+    TextEdit edit;
+    edit.offset = text.find("v50");
+    edit.removed = 3;
+    edit.inserted = "renamed\n";
+    const TokenDiff diff = buffer.applyEdit(edit);
+    EXPECT_FALSE(diff.full);
+    EXPECT_LE(diff.inserted, 8u);
+    EXPECT_EQ(diff.lineDelta, 1);
+}